@@ -68,6 +68,8 @@ enum SizedItemName
     siHashNodeDBCache,
     siTxnDBCache,
     siLgrDBCache,
+    siBookPageCacheSize,
+    siBookPageCacheAge,
 };
 
 struct SizedItem
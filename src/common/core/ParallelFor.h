@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_CORE_PARALLELFOR_H_INCLUDED
+#define SKYWELL_CORE_PARALLELFOR_H_INCLUDED
+
+#include <common/core/JobQueue.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace skywell {
+
+namespace detail {
+
+// Shared by the caller of parallelFor and the jobs it queues. A job can
+// outlive the call, so everything it touches lives here.
+struct ParallelForState
+{
+    std::function <void (std::size_t)> call;
+    std::size_t count;
+    std::atomic <std::size_t> next;
+
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::size_t active;
+    std::exception_ptr error;
+
+    ParallelForState (std::function <void (std::size_t)> c, std::size_t n)
+        : call (std::move (c))
+        , count (n)
+        , next (0)
+        , active (0)
+    {
+    }
+
+    // Make calls until every index has been handed out
+    void work ()
+    {
+        {
+            std::lock_guard <std::mutex> lock (mutex);
+            ++active;
+        }
+
+        try
+        {
+            for (std::size_t i = next++; i < count; i = next++)
+                call (i);
+        }
+        catch (...)
+        {
+            next = count;
+
+            std::lock_guard <std::mutex> lock (mutex);
+
+            if (!error)
+                error = std::current_exception ();
+        }
+
+        std::lock_guard <std::mutex> lock (mutex);
+
+        if (--active == 0)
+            idle.notify_all ();
+    }
+};
+
+}
+
+/** Call a function for each index in [0, count), spread over the job queue.
+
+    Indexes are handed out in order. One job of the given type is queued
+    for every perJobMin indexes beyond the first share, up to jobsMax in
+    all, and the calling thread works through the indexes too. A job that
+    starts after every index has been handed out returns at once, so the
+    caller never waits on the queue, and the work shows up in the queue's
+    load accounting. The function must be safe to call concurrently for
+    different indexes.
+
+    If a call throws, no further indexes are handed out. The first
+    exception is rethrown to the caller once every call in progress has
+    returned.
+*/
+template <class Function>
+void
+parallelFor (JobQueue& jobQueue, JobType type, std::string const& name,
+    std::size_t count, std::size_t perJobMin, std::size_t jobsMax,
+    Function const& f)
+{
+    auto state = std::make_shared <detail::ParallelForState> (
+        std::ref (f), count);
+
+    std::size_t const jobs = std::min <std::size_t> (
+        count / std::max <std::size_t> (perJobMin, 1), jobsMax);
+
+    for (std::size_t i = 1; i < jobs; ++i)
+    {
+        jobQueue.addJob (type, name,
+            [state] (Job&)
+            {
+                state->work ();
+            });
+    }
+
+    state->work ();
+
+    std::unique_lock <std::mutex> lock (state->mutex);
+
+    state->idle.wait (lock, [&state] { return state->active == 0; });
+
+    if (state->error)
+        std::rethrow_exception (state->error);
+}
+
+}
+
+#endif
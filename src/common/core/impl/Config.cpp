@@ -610,6 +610,9 @@ int Config::getSize (SizedItemName item) const
         { siHashNodeDBCache,    {   4,      12,     24,     64,         128      } },
         { siTxnDBCache,         {   4,      12,     24,     64,         128      } },
         { siLgrDBCache,         {   4,      8,      16,     32,         128      } },
+
+        { siBookPageCacheSize,  {   32,     64,     128,    256,        1024    } },
+        { siBookPageCacheAge,   {   10,     15,     30,     30,         30      } },
     };
 
     for (int i = 0; i < (sizeof (sizeTable) / sizeof (SizedItem)); ++i)
@@ -19,6 +19,8 @@
 
 #include <BeastConfig.h>
 #include <common/misc/CanonicalTXSet.h>
+#include <algorithm>
+#include <cassert>
 
 namespace skywell {
 
@@ -80,17 +82,59 @@ void CanonicalTXSet::push_back (STTx::ref txn)
 
     effectiveAccount ^= to256 (txn->getOperationAccount ().getAccountID ());
 
-    mMap.insert (std::make_pair (
-                     Key (effectiveAccount, txn->getSequence (), txn->getTransactionID ()),
-                     txn));
+    Key key (effectiveAccount, txn->getSequence (), txn->getTransactionID ());
+
+    // Transactions usually arrive in order, keep the set sorted if we can
+    if (mSorted && !mEntries.empty () && !(mEntries.back ().first < key))
+        mSorted = false;
+
+    mEntries.emplace_back (std::move (key), txn);
+    ++mLive;
 }
 
 CanonicalTXSet::iterator CanonicalTXSet::erase (iterator const& it)
 {
+    assert (it.mIt->second);
+
+    it.mIt->second.reset ();
+    --mLive;
+
     iterator tmp = it;
     ++tmp;
-    mMap.erase (it);
     return tmp;
 }
 
+void CanonicalTXSet::sort () const
+{
+    if (mSorted && (mLive == mEntries.size ()))
+        return;
+
+    // Drop the entries that were erased
+    mEntries.erase (std::remove_if (mEntries.begin (), mEntries.end (),
+        [] (value_type const& entry)
+        {
+            return !entry.second;
+        }), mEntries.end ());
+
+    if (!mSorted)
+    {
+        // The sort is stable so the first copy of a transaction is kept
+        std::stable_sort (mEntries.begin (), mEntries.end (),
+            [] (value_type const& lhs, value_type const& rhs)
+            {
+                return lhs.first < rhs.first;
+            });
+
+        mEntries.erase (std::unique (mEntries.begin (), mEntries.end (),
+            [] (value_type const& lhs, value_type const& rhs)
+            {
+                return lhs.first == rhs.first;
+            }), mEntries.end ());
+
+        mSorted = true;
+    }
+
+    mLive = mEntries.size ();
+}
+
 } // skywell
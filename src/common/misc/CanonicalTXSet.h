@@ -22,6 +22,8 @@
 
 #include <protocol/SkywellLedgerHash.h>
 #include <protocol/STTx.h>
+#include <iterator>
+#include <vector>
 
 namespace skywell {
 
@@ -71,12 +73,82 @@ public:
         std::uint32_t mSeq;
     };
 
-    typedef std::map <Key, STTx::pointer>::iterator iterator;
-    typedef std::map <Key, STTx::pointer>::const_iterator const_iterator;
+    typedef std::pair <Key, STTx::pointer> value_type;
+
+private:
+    typedef std::vector <value_type> Entries;
+
+    // Walks the entries in order, skipping the ones that were erased
+    template <class Value, class Base>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        Iterator (Base it, Base end)
+            : mIt (it)
+            , mEnd (end)
+        {
+            skip ();
+        }
+
+        reference operator* () const
+        {
+            return *mIt;
+        }
+        pointer operator-> () const
+        {
+            return &*mIt;
+        }
+
+        Iterator& operator++ ()
+        {
+            ++mIt;
+            skip ();
+            return *this;
+        }
+        Iterator operator++ (int)
+        {
+            Iterator tmp (*this);
+            ++*this;
+            return tmp;
+        }
+
+        bool operator== (Iterator const& rhs) const
+        {
+            return mIt == rhs.mIt;
+        }
+        bool operator!= (Iterator const& rhs) const
+        {
+            return mIt != rhs.mIt;
+        }
+
+    private:
+        friend class CanonicalTXSet;
+
+        void skip ()
+        {
+            while ((mIt != mEnd) && !mIt->second)
+                ++mIt;
+        }
+
+        Base mIt;
+        Base mEnd;
+    };
+
+public:
+    typedef Iterator <value_type, Entries::iterator> iterator;
+    typedef Iterator <value_type const, Entries::const_iterator> const_iterator;
 
 public:
     explicit CanonicalTXSet (LedgerHash const& lastClosedLedgerHash)
         : mSetHash (lastClosedLedgerHash)
+        , mLive (0)
+        , mSorted (true)
     {
     }
 
@@ -87,41 +159,56 @@ public:
     {
         mSetHash = newLastClosedLedgerHash;
 
-        mMap.clear ();
+        mEntries.clear ();
+        mLive = 0;
+        mSorted = true;
     }
 
+    /** Remove a transaction.
+        The entry is only marked as erased, so this takes constant time
+        and leaves other iterators valid.
+    */
     iterator erase (iterator const& it);
 
     iterator begin ()
     {
-        return mMap.begin ();
+        sort ();
+        return iterator (mEntries.begin (), mEntries.end ());
     }
     iterator end ()
     {
-        return mMap.end ();
+        return iterator (mEntries.end (), mEntries.end ());
     }
     const_iterator begin ()  const
     {
-        return mMap.begin ();
+        sort ();
+        return const_iterator (mEntries.begin (), mEntries.end ());
     }
     const_iterator end () const
     {
-        return mMap.end ();
+        return const_iterator (mEntries.end (), mEntries.end ());
     }
     size_t size () const
     {
-        return mMap.size ();
+        sort ();
+        return mLive;
     }
     bool empty () const
     {
-        return mMap.empty ();
+        return size () == 0;
     }
 
 private:
+    // Put new transactions in canonical order and drop erased entries
+    void sort () const;
+
     // Used to salt the accounts so people can't mine for low account numbers
     uint256 mSetHash;
 
-    std::map <Key, STTx::pointer> mMap;
+    // Sorted by key, unless transactions were added since the last sort
+    mutable Entries mEntries;
+    mutable std::size_t mLive;
+    mutable bool mSorted;
 };
 
 } // skywell
@@ -24,6 +24,7 @@
 #include <tuple>
 #include <consensus/LedgerConsensus.h>
 #include <data/database/DatabaseCon.h>
+#include <data/nodestore/Database.h>
 #include <main/Application.h>
 #include <ledger/AcceptedLedger.h>
 #include <ledger/InboundLedger.h>
@@ -40,6 +41,7 @@
 #include <common/misc/Validations.h>
 #include <common/misc/impl/AccountTxPaging.h>
 #include <common/misc/FeeVote.h>
+#include <common/base/KeyCache.h>
 #include <common/base/Log.h>
 #include <common/base/Time.h>
 #include <common/base/StringUtilities.h>
@@ -63,6 +65,7 @@
 #include <protocol/Indexes.h>
 #include <common/misc/Utility.h>
 #include <boost/lexical_cast.hpp>
+#include <limits>
 
 namespace skywell {
 
@@ -87,6 +90,7 @@ public:
     NetworkOPsImp (
             clock_type& clock, bool standalone, std::size_t network_quorum,
             JobQueue& job_queue, LedgerMaster& ledgerMaster, Stoppable& parent,
+            beast::insight::Collector::ptr const& collector,
             beast::Journal journal)
         : NetworkOPs (parent)
         , m_clock (clock)
@@ -94,6 +98,9 @@ public:
         , m_localTX (LocalTxs::New ())
         , m_feeVote (make_FeeVote (setup_FeeVote (getConfig().section ("voting")),
             deprecatedLogs().journal("FeeVote")))
+        , m_ledgerTiming (std::make_unique<AdaptiveLedgerTiming> (
+            setup_AdaptiveLedgerTiming (getConfig().section ("ledger_timing")),
+            collector, deprecatedLogs().journal("LedgerTiming")))
         , mMode (omDISCONNECTED)
         , mNeedNetworkLedger (false)
         , mProposing (false)
@@ -109,6 +116,11 @@ public:
         , mLastValidationTime (0)
         , mFetchPack ("FetchPack", 65536, 45, clock,
             deprecatedLogs().journal("TaggedCache"))
+        , mBookPages ("BookPages", getConfig ().getSize (siBookPageCacheSize),
+            getConfig ().getSize (siBookPageCacheAge), clock,
+                deprecatedLogs().journal("TaggedCache"))
+        , mBookPageRequests ("BookPageRequests", clock, 0,
+            getConfig ().getSize (siBookPageCacheAge))
         , mFetchSeq (0)
         , mLastLoadBase (256)
         , mLastLoadFactor (256)
@@ -222,6 +234,9 @@ public:
     Transaction::pointer processTransactionCb (
         Transaction::pointer,
         bool bAdmin, bool bLocal, bool bFailHard, stCallback);
+
+    // Queue a transaction the open ledger turned away, returns true if queued
+    bool queueTransaction (STTx::ref txn, TER result);
     Transaction::pointer processTransaction (
         Transaction::pointer transaction,
         bool bAdmin, bool bLocal, bool bFailHard)
@@ -280,6 +295,20 @@ public:
         Account const& uTakerID, const bool bProof, const unsigned int iLimit,
             Json::Value const& jvMarker, Json::Value& jvResult);
 
+    void sweepBookPages ();
+
+private:
+    // Append up to left offers from the top of the book to jvOffers
+    void walkBookPage (Ledger::ref lpLedger, Book const& book,
+        Account const& uTakerID, unsigned int left, Json::Value& jvOffers);
+
+    // The top of a book in a closed ledger. A book is only cached once
+    // it has been asked for twice, the first request returns null.
+    std::shared_ptr<Json::Value> getCachedBookPage (Ledger::ref lpLedger,
+        Book const& book, Account const& uTakerID);
+
+public:
+
     // ledger proposal/close functions
     void processTrustedProposal (
         LedgerProposal::pointer proposal,
@@ -302,6 +331,10 @@ public:
 
     bool shouldFetchPack (std::uint32_t seq);
     void gotFetchPack (bool progress, std::uint32_t seq);
+    void expectCatchUpPack (uint256 const& ledgerHash, std::uint32_t peer);
+    void gotCatchUpPack (
+        Job&, std::weak_ptr<Peer> peer,
+        std::shared_ptr<protocol::TMGetObjectByHash> pack);
     void addFetchPack (uint256 const& hash, std::shared_ptr< Blob >& data);
     bool getFetchPack (uint256 const& hash, Blob& data);
     int getFetchSize ();
@@ -375,6 +408,10 @@ public:
     {
         return mLastCloseConvergeTime;
     }
+    AdaptiveLedgerTiming& getLedgerTiming ()
+    {
+        return *m_ledgerTiming;
+    }
     std::uint32_t getLastCloseTime ()
     {
         return mLastCloseTime;
@@ -480,7 +517,7 @@ public:
     bool subServer (InfoSub::ref ispListener, Json::Value& jvResult, bool admin);
     bool unsubServer (std::uint64_t uListener);
 
-    bool subBook (InfoSub::ref ispListener, Book const&) override;
+    bool subBook (InfoSub::ref ispListener, Book const&, bool delta) override;
     bool unsubBook (std::uint64_t uListener, Book const&) override;
 
     bool subTransactions (InfoSub::ref ispListener);
@@ -546,6 +583,7 @@ private:
 
     std::unique_ptr <LocalTxs> m_localTX;
     std::unique_ptr <FeeVote> m_feeVote;
+    std::unique_ptr <AdaptiveLedgerTiming> m_ledgerTiming;
 
     LockType mSubLock;
 
@@ -596,6 +634,17 @@ private:
     SubMapType mSubRTTransactions;     // all proposed and accepted transactions
 
     TaggedCache<uint256, Blob>  mFetchPack;
+
+    // Catch-up packs we asked for, by the ledger we asked from, with the
+    // peer asked and when
+    std::mutex mCatchUpLock;
+    hash_map<uint256, std::pair<Peer::id_t, int>> mCatchUpRequests;
+
+    // Pages of books in closed ledgers, which can never change
+    TaggedCache<uint256, Json::Value> mBookPages;
+
+    // Pages asked for once, which are cached if asked for again
+    KeyCache<uint256> mBookPageRequests;
     std::uint32_t mFetchSeq;
 
     std::uint32_t mLastLoadBase;
@@ -1034,6 +1083,13 @@ Transaction::pointer NetworkOPsImp::processTransactionCb (
             trans->getSTransaction(),
             bAdmin ? (tapOPEN_LEDGER | tapNO_CHECK_SIGN | tapADMIN)
             : (tapOPEN_LEDGER | tapNO_CHECK_SIGN), didApply);
+
+        if (((r == telINSUF_FEE_P) || (r == terPRE_SEQ)) && !bFailHard &&
+            queueTransaction (trans->getSTransaction (), r))
+        {
+            r = terQUEUED;
+        }
+
         trans->setResult (r);
 
         if (isTemMalformed (r)) // malformed, cache bad
@@ -1072,6 +1128,12 @@ Transaction::pointer NetworkOPsImp::processTransactionCb (
             m_journal.info << "Transaction is obsolete";
             trans->setStatus (OBSOLETE);
         }
+        else if (r == terQUEUED)
+        {
+            m_journal.debug << "Transaction is queued";
+            trans->setStatus (HELD);
+            getApp().getMasterTransaction ().canonicalize (&trans);
+        }
         else if (isTerRetry (r))
         {
             if (bFailHard)
@@ -1125,6 +1187,28 @@ Transaction::pointer NetworkOPsImp::processTransactionCb (
     return trans;
 }
 
+bool NetworkOPsImp::queueTransaction (STTx::ref txn, TER result)
+{
+    auto const ledger = m_ledgerMaster.getCurrentLedger ();
+
+    std::uint64_t const loadBase = getApp().getFeeTrack ().getLoadBase ();
+    std::uint64_t const baseFee = ledger->scaleFeeBase (
+        getConfig ().TRANSACTION_FEE_BASE);
+    std::uint64_t const paid = txn->getTransactionFee ().mantissa ();
+
+    // The fee paid relative to the base fee, in units of the load base
+    std::uint64_t feeLevel = std::numeric_limits<std::uint64_t>::max ();
+
+    if ((baseFee != 0) && (paid < (feeLevel / loadBase)))
+        feeLevel = paid * loadBase / baseFee;
+
+    // Only queue transactions that would pay enough without any load
+    if ((result == telINSUF_FEE_P) && (feeLevel < loadBase))
+        return false;
+
+    return m_ledgerMaster.getTxQ ().add (ledger->getLedgerSeq (), txn, feeLevel);
+}
+
 Transaction::pointer NetworkOPsImp::findTransactionByID (
     uint256 const& transactionID)
 {
@@ -2099,6 +2183,9 @@ Json::Value NetworkOPsImp::getServerInfo (bool human, bool admin)
         {
             info[jss::pubkey_validator] = "none";
         }
+
+        info[jss::queue] = m_ledgerMaster.getTxQ ().getJson ();
+        info[jss::ledger_timing] = m_ledgerTiming->getJson ();
     }
 
     info[jss::pubkey_node] =
@@ -2366,6 +2453,8 @@ void NetworkOPsImp::pubLedger (Ledger::ref accepted)
         m_journal.trace << "pubAccepted: " << vt.second->getJson ();
         pubValidatedTransaction (lpAccepted, *vt.second);
     }
+
+    getApp().getOrderBookDB ().pubBookDeltas (lpAccepted);
 }
 
 void NetworkOPsImp::reportFeeChange ()
@@ -2628,10 +2717,11 @@ void NetworkOPsImp::unsubAccountInternal (
     }
 }
 
-bool NetworkOPsImp::subBook (InfoSub::ref isrListener, Book const& book)
+bool NetworkOPsImp::subBook (InfoSub::ref isrListener, Book const& book,
+    bool delta)
 {
     if (auto listeners = getApp().getOrderBookDB ().makeBookListeners (book))
-        listeners->addSubscriber (isrListener);
+        listeners->addSubscriber (isrListener, delta);
     else
         assert (false);
     return true;
@@ -2793,6 +2883,9 @@ InfoSub::pointer NetworkOPsImp::addRpcSub (
     return rspEntry;
 }
 
+// The most offers we keep for a book in a closed ledger
+static unsigned int const bookPageCacheMax = 300;
+
 #ifndef USE_NEW_BOOK_PAGE
 
 // NIKB FIXME this should be looked at. There's no reason why this shouldn't
@@ -2808,10 +2901,70 @@ void NetworkOPsImp::getBookPage (
     const unsigned int iLimit,
     Json::Value const& jvMarker,
     Json::Value& jvResult)
-{ // CAUTION: This is the old get book page logic
+{
     Json::Value& jvOffers =
             (jvResult[jss::offers] = Json::Value (Json::arrayValue));
 
+    unsigned int left (iLimit == 0 ? 300 : iLimit);
+    if (! bAdmin && left > 300)
+        left = 300;
+
+    if (!lpLedger->isClosed () || (left > bookPageCacheMax))
+    {
+        walkBookPage (lpLedger, book, uTakerID, left, jvOffers);
+        return;
+    }
+
+    // Offers are funded in book order, so a shorter page is a prefix
+    // of the cached one
+    auto const page = getCachedBookPage (lpLedger, book, uTakerID);
+
+    if (!page)
+    {
+        walkBookPage (lpLedger, book, uTakerID, left, jvOffers);
+        return;
+    }
+
+    Json::Value const& offers = *page;
+
+    for (Json::UInt i = 0; (i < left) && (i < offers.size ()); ++i)
+        jvOffers.append (offers[i]);
+}
+
+std::shared_ptr<Json::Value> NetworkOPsImp::getCachedBookPage (
+    Ledger::ref lpLedger, Book const& book, Account const& uTakerID)
+{
+    // Only whether the taker is the issuer changes the page
+    Serializer s (80);
+    s.add256 (lpLedger->getHash ());
+    s.add256 (getBookBase (book));
+    s.add8 ((uTakerID == book.out.account) ? 1 : 0);
+
+    uint256 const key = s.getSHA512Half ();
+
+    auto page = mBookPages.fetch (key);
+
+    if (!page)
+    {
+        // Most books are only asked for once per ledger
+        if (mBookPageRequests.insert (key))
+            return page;
+
+        page = std::make_shared<Json::Value> (Json::arrayValue);
+        walkBookPage (lpLedger, book, uTakerID, bookPageCacheMax, *page);
+        mBookPages.canonicalize (key, page);
+    }
+
+    return page;
+}
+
+void NetworkOPsImp::walkBookPage (
+    Ledger::ref lpLedger,
+    Book const& book,
+    Account const& uTakerID,
+    unsigned int left,
+    Json::Value& jvOffers)
+{ // CAUTION: This is the old get book page logic
     std::map<Account, STAmount> umBalance;
     const uint256   uBookBase   = getBookBase (book);
     const uint256   uBookEnd    = getQualityNext (uBookBase);
@@ -2840,10 +2993,6 @@ void NetworkOPsImp::getBookPage (
 
     auto uTransferRate = skywellTransferRate (lesActive, book.out.account);
 
-    unsigned int left (iLimit == 0 ? 300 : iLimit);
-    if (! bAdmin && left > 300)
-        left = 300;
-
     while (!bDone && left-- > 0)
     {
         if (bDirectAdvance)
@@ -3165,6 +3314,17 @@ void NetworkOPsImp::getBookPage (
 
 #endif
 
+// Limits on the size of the fetch packs we build
+static int const fetchPackObjectsMax = 512;
+static int const catchUpPackObjectsMax = 8192;
+
+// How long we wait for a catch-up pack we asked for, in seconds
+static int const catchUpPackTimeout = 60;
+
+// A prefixed ledger header: prefix, sequence, total coins, three hashes,
+// two close times, close resolution and close flags
+static std::size_t const catchUpHeaderSize = 4 + 4 + 8 + (3 * 32) + 4 + 4 + 1 + 1;
+
 static void fpAppender (
     protocol::TMGetObjectByHash* reply, std::uint32_t ledgerSeq,
     uint256 const& hash, const Blob& blob)
@@ -3236,6 +3396,12 @@ void NetworkOPsImp::makeFetchPack (
         return;
     }
 
+    // A peer that is far behind asks for a "fat" pack, which covers
+    // as many ledgers as we can fit in a much larger pack.
+    bool const catchUp = request->has_fat () && request->fat ();
+    int const objectsMax = catchUp ?
+        catchUpPackObjectsMax : fetchPackObjectsMax;
+
     try
     {
         protocol::TMGetObjectByHash reply;
@@ -3247,13 +3413,16 @@ void NetworkOPsImp::makeFetchPack (
         reply.set_ledgerhash (request->ledgerhash ());
         reply.set_type (protocol::TMGetObjectByHash::otFETCH_PACK);
 
+        if (catchUp)
+            reply.set_fat (true);
+
         // Building a fetch pack:
         //  1. Add the header for the requested ledger.
         //  2. Add the nodes for the AccountStateMap of that ledger.
         //  3. If there are transactions, add the nodes for the
         //     transactions of the ledger.
         //  4. If the FetchPack now contains greater than or equal to
-        //     256 entries then stop.
+        //     objectsMax entries then stop.
         //  5. If not very much time has elapsed, then loop back and repeat
         //     the same process adding the previous ledger to the FetchPack.
         do
@@ -3268,18 +3437,26 @@ void NetworkOPsImp::makeFetchPack (
             newObj.set_data (s.getDataPtr (), s.getLength ());
             newObj.set_ledgerseq (lSeq);
 
+            // A catch-up pack never holds more than objectsMax nodes,
+            // give or take the last node of each map
+            auto const remaining = [&] ()
+            {
+                return std::max (1, objectsMax - reply.objects ().size ());
+            };
+
             wantLedger->peekAccountStateMap ()->getFetchPack
-                (haveLedger->peekAccountStateMap ().get (), true, 16384,
+                (haveLedger->peekAccountStateMap ().get (), true,
+                    catchUp ? remaining () : 16384,
                     std::bind (fpAppender, &reply, lSeq, std::placeholders::_1,
                                std::placeholders::_2));
 
             if (wantLedger->getTransHash ().isNonZero ())
                 wantLedger->peekTransactionMap ()->getFetchPack (
-                    nullptr, true, 512,
+                    nullptr, true, catchUp ? remaining () : 512,
                     std::bind (fpAppender, &reply, lSeq, std::placeholders::_1,
                                std::placeholders::_2));
 
-            if (reply.objects ().size () >= 512)
+            if (reply.objects ().size () >= objectsMax)
                 break;
 
             // move may save a ref/unref
@@ -3291,6 +3468,15 @@ void NetworkOPsImp::makeFetchPack (
 
         m_journal.info
             << "Built fetch pack with " << reply.objects ().size () << " nodes";
+
+        // The peer was charged for an ordinary pack up front, charge the
+        // rest in proportion to what we built
+        int const extra = (reply.objects ().size () - 1) / fetchPackObjectsMax;
+
+        if (extra > 0)
+            peer->charge (Resource::Charge (
+                Resource::feeHighBurdenPeer.cost () * extra, "large fetch pack"));
+
         auto msg = std::make_shared<Message> (reply, protocol::mtGET_OBJECTS);
         peer->send (msg);
     }
@@ -3305,6 +3491,12 @@ void NetworkOPsImp::sweepFetchPack ()
     mFetchPack.sweep ();
 }
 
+void NetworkOPsImp::sweepBookPages ()
+{
+    mBookPages.sweep ();
+    mBookPageRequests.sweep ();
+}
+
 void NetworkOPsImp::addFetchPack (
     uint256 const& hash, std::shared_ptr< Blob >& data)
 {
@@ -3355,6 +3547,236 @@ void NetworkOPsImp::gotFetchPack (bool progress, std::uint32_t seq)
                    &getApp().getInboundLedgers (), std::placeholders::_1));
 }
 
+void NetworkOPsImp::expectCatchUpPack (
+    uint256 const& ledgerHash, std::uint32_t peer)
+{
+    std::lock_guard <std::mutex> lock (mCatchUpLock);
+
+    auto const now = UptimeTimer::getInstance ().getElapsedSeconds ();
+
+    for (auto it = mCatchUpRequests.begin (); it != mCatchUpRequests.end (); )
+    {
+        if ((it->second.second + catchUpPackTimeout) < now)
+            it = mCatchUpRequests.erase (it);
+        else
+            ++it;
+    }
+
+    mCatchUpRequests[ledgerHash] = std::make_pair (peer, now);
+}
+
+void NetworkOPsImp::gotCatchUpPack (
+    Job&, std::weak_ptr<Peer> wPeer,
+    std::shared_ptr<protocol::TMGetObjectByHash> pack)
+{
+    auto peer = wPeer.lock ();
+
+    if (!peer)
+        return;
+
+    uint256 haveHash;
+
+    if (pack->ledgerhash ().size () == (256 / 8))
+        memcpy (haveHash.begin (), pack->ledgerhash ().data (), 256 / 8);
+
+    // Only take packs we asked this peer for, and only once
+    {
+        std::lock_guard <std::mutex> lock (mCatchUpLock);
+
+        auto const it = mCatchUpRequests.find (haveHash);
+
+        if ((it == mCatchUpRequests.end ()) || (it->second.first != peer->id ()) ||
+            ((it->second.second + catchUpPackTimeout) <
+                UptimeTimer::getInstance ().getElapsedSeconds ()))
+        {
+            m_journal.debug << "Unsolicited catch-up pack";
+            peer->charge (Resource::feeUnwantedData);
+            return;
+        }
+
+        mCatchUpRequests.erase (it);
+    }
+
+    // The builder can go over its limit by the last node of each map
+    if (pack->objects_size () > (catchUpPackObjectsMax + 2))
+    {
+        m_journal.warning << "Oversized catch-up pack";
+        peer->charge (Resource::feeInvalidRequest);
+        return;
+    }
+
+    struct Header
+    {
+        std::uint32_t seq;
+        uint256 hash;
+        uint256 parentHash;
+        uint256 accountHash;
+        uint256 transHash;
+    };
+
+    std::vector<Header> headers;
+    hash_map<uint256, Blob> objects;
+
+    // Verify every object before we store any of them
+    for (auto const& obj : pack->objects ())
+    {
+        if ((obj.hash ().size () != (256 / 8)) || (obj.data ().size () < 4))
+        {
+            m_journal.warning << "Malformed catch-up pack";
+            peer->charge (Resource::feeInvalidRequest);
+            return;
+        }
+
+        uint256 hash;
+        memcpy (hash.begin (), obj.hash ().data (), 256 / 8);
+
+        Blob data (obj.data ().begin (), obj.data ().end ());
+
+        if (hash != getSHA512Half (data))
+        {
+            m_journal.warning << "Bad entry in catch-up pack";
+            peer->charge (Resource::feeBadData);
+            return;
+        }
+
+        std::uint32_t const prefix = (data[0] << 24) | (data[1] << 16) |
+            (data[2] << 8) | data[3];
+
+        if (prefix == HashPrefix::ledgerMaster)
+        {
+            // The peer chose both the hash and the data, so the data may
+            // not be a header at all
+            Ledger::pointer ledger;
+
+            if (data.size () == catchUpHeaderSize)
+            {
+                try
+                {
+                    ledger = std::make_shared<Ledger> (data, true);
+                }
+                catch (...)
+                {
+                }
+            }
+
+            if (!ledger || (ledger->getHash () != hash))
+            {
+                m_journal.warning << "Bad ledger header in catch-up pack";
+                peer->charge (Resource::feeInvalidRequest);
+                return;
+            }
+
+            headers.push_back ({ledger->getLedgerSeq (), ledger->getHash (),
+                ledger->getParentHash (), ledger->getAccountHash (),
+                ledger->getTransHash ()});
+        }
+
+        objects.emplace (hash, std::move (data));
+    }
+
+    if (headers.empty ())
+        return;
+
+    // The pack must hold an unbroken chain of ledgers, newest first,
+    // leading down from a ledger we already trust.
+    std::sort (headers.begin (), headers.end (),
+        [] (Header const& a, Header const& b)
+        {
+            return a.seq > b.seq;
+        });
+
+    for (std::size_t i = 1; i < headers.size (); ++i)
+    {
+        if ((headers[i].seq + 1 != headers[i - 1].seq) ||
+            (headers[i].hash != headers[i - 1].parentHash))
+        {
+            m_journal.warning << "Catch-up pack has a broken ledger chain";
+            peer->charge (Resource::feeBadData);
+            return;
+        }
+    }
+
+    Ledger::pointer haveLedger = haveHash.isNonZero () ?
+        getLedgerByHash (haveHash) : Ledger::pointer ();
+
+    uint256 const expected = haveLedger ?
+        haveLedger->getParentHash () :
+        m_ledgerMaster.walkHashBySeq (headers.front ().seq);
+
+    if (expected != headers.front ().hash)
+    {
+        m_journal.info << "Catch-up pack does not connect to ledger "
+            << headers.front ().seq;
+        return;
+    }
+
+    // Store only what the verified headers lead to, walking each ledger's
+    // state and transaction trees through the pack. Anything not in the
+    // pack is something the peer expected us to have already.
+    std::vector<std::pair<uint256, NodeObjectType>> pending;
+
+    for (auto const& header : headers)
+    {
+        pending.emplace_back (header.hash, hotLEDGER);
+
+        if (header.accountHash.isNonZero ())
+            pending.emplace_back (header.accountHash, hotACCOUNT_NODE);
+
+        if (header.transHash.isNonZero ())
+            pending.emplace_back (header.transHash, hotTRANSACTION_NODE);
+    }
+
+    int stored = 0;
+
+    while (!pending.empty ())
+    {
+        auto const node = pending.back ();
+        pending.pop_back ();
+
+        auto it = objects.find (node.first);
+
+        if (it == objects.end ())
+            continue;
+
+        Blob data (std::move (it->second));
+        objects.erase (it);
+
+        std::uint32_t const prefix = (data[0] << 24) | (data[1] << 16) |
+            (data[2] << 8) | data[3];
+
+        if ((node.second != hotLEDGER) && (prefix == HashPrefix::innerNode))
+        {
+            if (data.size () != (4 + (16 * (256 / 8))))
+                continue;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                uint256 child;
+                memcpy (child.begin (), &data[4 + (i * (256 / 8))], 256 / 8);
+
+                if (child.isNonZero ())
+                    pending.emplace_back (child, node.second);
+            }
+        }
+
+        getApp().getNodeStore ().store (node.second, std::move (data), node.first);
+        ++stored;
+    }
+
+    if (!objects.empty ())
+    {
+        m_journal.debug << "Dropped " << objects.size ()
+            << " unreachable nodes from catch-up pack";
+    }
+
+    m_journal.info << "Stored catch-up pack for ledgers "
+        << headers.back ().seq << " to " << headers.front ().seq
+        << " with " << stored << " nodes";
+
+    gotFetchPack (true, headers.back ().seq);
+    m_ledgerMaster.tryAdvance ();
+}
+
 void NetworkOPsImp::missingNodeInLedger (std::uint32_t seq)
 {
     // prevent recursive invocation
@@ -3412,10 +3834,11 @@ NetworkOPs::~NetworkOPs ()
 std::unique_ptr<NetworkOPs>
 make_NetworkOPs (NetworkOPs::clock_type& clock, bool standalone,
     std::size_t network_quorum, JobQueue& job_queue, LedgerMaster& ledgerMaster,
-    beast::Stoppable& parent, beast::Journal journal)
+    beast::Stoppable& parent, beast::insight::Collector::ptr const& collector,
+    beast::Journal journal)
 {
     return std::make_unique<NetworkOPsImp> (clock, standalone, network_quorum,
-        job_queue, ledgerMaster, parent, journal);
+        job_queue, ledgerMaster, parent, collector, journal);
 }
 
 } // skywell
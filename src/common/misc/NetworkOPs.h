@@ -27,6 +27,7 @@
 #include <common/misc/Utility.h>
 #include <common/core/JobQueue.h>
 #include <protocol/STValidation.h>
+#include <ledger/AdaptiveLedgerTiming.h>
 #include <ledger/Ledger.h>
 #include <ledger/LedgerProposal.h>
 #include <services/net/InfoSub.h>
@@ -224,11 +225,24 @@ public:
 
     virtual bool shouldFetchPack (std::uint32_t seq) = 0;
     virtual void gotFetchPack (bool progress, std::uint32_t seq) = 0;
+
+    /** Note that we asked a peer for a catch-up pack from a ledger. */
+    virtual void expectCatchUpPack (uint256 const& ledgerHash,
+        std::uint32_t peer) = 0;
+
+    /** Take a catch-up fetch pack spanning many ledgers.
+        Only packs we asked for are taken. The header chain is checked,
+        then the nodes the headers lead to are written straight to the
+        node store.
+    */
+    virtual void gotCatchUpPack (Job&, std::weak_ptr<Peer> peer,
+        std::shared_ptr<protocol::TMGetObjectByHash> pack) = 0;
     virtual void addFetchPack (
         uint256 const& hash, std::shared_ptr< Blob >& data) = 0;
     virtual bool getFetchPack (uint256 const& hash, Blob& data) = 0;
     virtual int getFetchSize () = 0;
     virtual void sweepFetchPack () = 0;
+    virtual void sweepBookPages () = 0;
 
     // network state machine
     virtual void endConsensus (bool correctLCL) = 0;
@@ -250,6 +264,7 @@ public:
     virtual void consensusViewChange () = 0;
     virtual int getPreviousProposers () = 0;
     virtual int getPreviousConvergeTime () = 0;
+    virtual AdaptiveLedgerTiming& getLedgerTiming () = 0;
     virtual std::uint32_t getLastCloseTime () = 0;
     virtual void setLastCloseTime (std::uint32_t t) = 0;
 
@@ -325,7 +340,8 @@ public:
 std::unique_ptr<NetworkOPs>
 make_NetworkOPs (NetworkOPs::clock_type& clock, bool standalone,
     std::size_t network_quorum, JobQueue& job_queue, LedgerMaster& ledgerMaster,
-    beast::Stoppable& parent, beast::Journal journal);
+    beast::Stoppable& parent, beast::insight::Collector::ptr const& collector,
+    beast::Journal journal);
 
 } // skywell
 
@@ -37,9 +37,11 @@
 #include <common/core/Config.h>
 #include <common/core/JobQueue.h>
 #include <common/core/LoadFeeTrack.h>
+#include <common/core/ParallelFor.h>
 #include <common/json/to_string.h>
 #include <transaction/tx/TransactionAcquire.h>
 #include <transaction/tx/InboundTransactions.h>
+#include <transaction/tx/TransactionMaster.h>
 #include <network/overlay/Overlay.h>
 #include <network/overlay/predicates.h>
 #include <protocol/STValidation.h>
@@ -694,7 +696,7 @@ public:
         {
             closeLedger ();
         }*/
-        if(sinceClose >= 5000)
+        if (sinceClose >= getApp().getOPs ().getLedgerTiming ().getCloseInterval ())
         {
             closeLedger ();
         }
@@ -708,7 +710,7 @@ public:
     {
 
         // Give everyone a chance to take an initial position
-        if (mCurrentMSeconds < LEDGER_MIN_CONSENSUS)
+        if (mCurrentMSeconds < getApp().getOPs ().getLedgerTiming ().getMinConsensus ())
             return;
 
         updateOurPositions ();
@@ -789,7 +791,9 @@ public:
         // Determine if we actually have consensus or not
         return ContinuousLedgerTiming::haveConsensus (mPreviousProposers,
             agree + disagree, agree, currentValidations
-            , mPreviousMSeconds, mCurrentMSeconds, forReal, mConsensusFail);
+            , mPreviousMSeconds, mCurrentMSeconds
+            , getApp().getOPs ().getLedgerTiming ().getMinConsensus ()
+            , forReal, mConsensusFail);
     }
 
     std::shared_ptr<SHAMap> getTransactionTree (uint256 const& hash)
@@ -865,12 +869,21 @@ public:
                                             << newPosition->getCurrentHash ();
         currentPosition = newPosition;
 
+        if ((newPosition->getProposeSeq () == 0) && (mState == lcsESTABLISH))
+        {
+            // How long after our close the peer's initial position came
+            getApp().getOPs ().getLedgerTiming ().onProposal (
+                std::chrono::duration_cast<std::chrono::milliseconds> (
+                    std::chrono::steady_clock::now () - mConsensusStartTime).count ());
+        }
+
         std::shared_ptr<SHAMap> set = getTransactionTree (newPosition->getCurrentHash ());
 
         if (set)
         {
             for (auto& it : mDisputes)
-                it.second->setVote (peerID, set->hasItem (it.first));
+                it.second->setVote (peerID,
+                    setHasTransaction (set, it.first));
         }
         else
         {
@@ -905,6 +918,7 @@ private:
     */
     void accept (std::shared_ptr<SHAMap> set)
     {
+        auto const acceptStart = std::chrono::steady_clock::now ();
 
         {
             std::lock_guard<Application::MutexType> lock(getApp().getMasterMutex());
@@ -1024,6 +1038,7 @@ private:
         getApp().getLedgerMaster().consensusBuilt (newLCL);
 
         // Build new open ledger
+        auto const buildStart = std::chrono::steady_clock::now ();
         Ledger::pointer newOL = std::make_shared<Ledger>(true, *newLCL);
 
         // Apply disputed transactions that didn't get in
@@ -1041,7 +1056,8 @@ private:
                         << " not get in";
 
                     SerialIter sit (it.second->peekTransaction ());
-                    STTx::pointer txn = std::make_shared<STTx>(sit);
+                    STTx::pointer txn = getApp().getMasterTransaction ().parse (
+                        it.second->getTransactionID (), sit);
 
                     retriableTransactions.push_back (txn);
                     anyDisputes = true;
@@ -1060,6 +1076,30 @@ private:
                 newOL, newLCL, retriableTransactions, true);
         }
 
+        // Take a snapshot of the old open ledger's transactions and replay
+        // them without holding the locks, so submissions are not blocked
+        // while the bulk of the new open ledger is built. Only the
+        // transactions that arrive in the meantime are applied below.
+        std::shared_ptr<SHAMap> replayed;
+        {
+            std::lock_guard<std::recursive_mutex> lock (
+                getApp().getMasterMutex ());
+
+            Ledger::pointer oldOL = getApp().getLedgerMaster().getCurrentLedger();
+            if (oldOL->peekTransactionMap()->getHash().isNonZero ())
+                replayed = oldOL->peekTransactionMap ()->snapShot (false);
+        }
+
+        if (replayed)
+        {
+            WriteLog (lsDEBUG, LedgerConsensus) << "Applying transactions from current open ledger";
+
+            applyTransactions (replayed, newOL, newLCL,
+                               retriableTransactions, true);
+        }
+
+        auto const lockStart = std::chrono::steady_clock::now ();
+
         {
             auto lock = std::unique_lock<std::recursive_mutex>(getApp().getMasterMutex(), std::defer_lock);
             
@@ -1067,14 +1107,14 @@ private:
                 (getApp().getLedgerMaster ().peekMutex (), std::defer_lock);
             std::lock(lock, sl);
 
-            // Apply transactions from the old open ledger
+            // Apply transactions that reached the old open ledger after
+            // the snapshot was taken
             Ledger::pointer oldOL = getApp().getLedgerMaster().getCurrentLedger();
             if (oldOL->peekTransactionMap()->getHash().isNonZero ())
             {
-                WriteLog (lsDEBUG, LedgerConsensus) << "Applying transactions from current open ledger";
-
                 applyTransactions (oldOL->peekTransactionMap (),
-                                   newOL, newLCL, retriableTransactions, true);
+                                   newOL, newLCL, retriableTransactions, true,
+                                   replayed);
             }
 
             // Apply local transactions
@@ -1085,6 +1125,20 @@ private:
             getApp().getLedgerMaster ().pushLedger (newLCL, newOL);
         }
 
+        {
+            using namespace std::chrono;
+            auto const now = steady_clock::now ();
+
+            WriteLog (lsINFO, LedgerConsensus) << "Built open ledger in "
+                << duration_cast<milliseconds> (now - buildStart).count ()
+                << "ms, "
+                << duration_cast<milliseconds> (now - lockStart).count ()
+                << "ms locked";
+
+            getApp().getOPs ().getLedgerTiming ().onAccept (
+                duration_cast<milliseconds> (now - acceptStart).count ());
+        }
+
         mNewLedgerHash = newLCL->getHash ();
         mState = lcsACCEPTED;
 
@@ -1125,6 +1179,72 @@ private:
         }
     }
 
+    /**
+      Get the transactions in which a set differs from the diff base
+
+      Every set is compared against the same base set, once, so the
+      differences between any two sets follow from their cached diffs
+      without walking either tree again, and peers taking the same
+      position share one entry.
+
+      @param set The transaction set, which must be immutable
+      @return    The IDs of transactions in only one of set and the base,
+                 or null if there were too many differences to track
+    */
+    hash_set<uint256> const* getSetDiff (std::shared_ptr<SHAMap> const& set)
+    {
+        if (!mDiffBase)
+            mDiffBase = set;
+
+        auto it = mSetDiffs.find (set->getHash ());
+
+        if (it != mSetDiffs.end ())
+            return it->second.get ();
+
+        std::unique_ptr<hash_set<uint256>> diff;
+
+        SHAMap::Delta differences;
+
+        if (mDiffBase->compare (set, differences, 16384))
+        {
+            diff = std::make_unique<hash_set<uint256>> ();
+            diff->reserve (differences.size ());
+
+            for (auto const& pos : differences)
+                diff->insert (pos.first);
+        }
+        else
+        {
+            WriteLog (lsWARNING, LedgerConsensus) << "Transaction set "
+                << set->getHash () << " has too many differences to cache";
+        }
+
+        return (mSetDiffs[set->getHash ()] = std::move (diff)).get ();
+    }
+
+    /**
+      Check whether a transaction set contains a disputed transaction,
+        using the cached diff of the set
+
+      @param set  The transaction set
+      @param txID The ID of the transaction
+    */
+    bool setHasTransaction (std::shared_ptr<SHAMap> const& set,
+                            uint256 const& txID)
+    {
+        hash_set<uint256> const* diff = getSetDiff (set);
+
+        if (!diff)
+            return set->hasItem (txID);
+
+        auto it = mBaseHas.find (txID);
+
+        if (it == mBaseHas.end ())
+            it = mBaseHas.emplace (txID, mDiffBase->hasItem (txID)).first;
+
+        return it->second != (diff->count (txID) != 0);
+    }
+
     /**
       Compare two proposed transaction sets and create disputed
         transctions structures for any mismatches
@@ -1140,34 +1260,56 @@ private:
 
         WriteLog (lsDEBUG, LedgerConsensus) << "createDisputes "
             << m1->getHash() << " to " << m2->getHash();
-        SHAMap::Delta differences;
-        m1->compare (m2, differences, 16384);
+
+        hash_set<uint256> const* diff1 = getSetDiff (m1);
+        hash_set<uint256> const* diff2 = getSetDiff (m2);
 
         int dc = 0;
-        // for each difference between the transactions
-        for (auto& pos : differences)
+
+        // A transaction is in one set but not the other when exactly one
+        // of the sets differs from the base on it
+        auto dispute = [&] (uint256 const& txID)
         {
             ++dc;
-            // create disputed transactions (from the ledger that has them)
-            if (pos.second.first)
-            {
-                // transaction is only in first map
-                assert (!pos.second.second);
 
-                addDisputedTransaction (pos.first , pos.second.first->peekData ());
-            }
-            else if (pos.second.second)
-            {
-                // transaction is only in second map
-                assert (!pos.second.first);
+            if (mDisputes.find (txID) != mDisputes.end ())
+                return;
+
+            // create disputed transactions (from the set that has them)
+            std::shared_ptr<SHAMapItem> item = m1->peekItem (txID);
 
-                addDisputedTransaction (pos.first, pos.second.second->peekData ());
+            if (!item)
+                item = m2->peekItem (txID);
+
+            if (item)
+                addDisputedTransaction (txID, item->peekData ());
+            else
+                assert (false);
+        };
+
+        if (diff1 && diff2)
+        {
+            for (auto const& txID : *diff1)
+            {
+                if (diff2->count (txID) == 0)
+                    dispute (txID);
             }
-            else // No other disagreement over a transaction should be possible
+
+            for (auto const& txID : *diff2)
             {
-                assert (false);
+                if (diff1->count (txID) == 0)
+                    dispute (txID);
             }
         }
+        else
+        {
+            // One of the sets is too far from the base, compare directly
+            SHAMap::Delta differences;
+            m1->compare (m2, differences, 16384);
+
+            for (auto const& pos : differences)
+                dispute (pos.first);
+        }
 
         WriteLog (lsDEBUG, LedgerConsensus) << dc << " differences found";
     }
@@ -1195,7 +1337,7 @@ private:
             auto mit (mAcquired.find (mOurPosition->getCurrentHash ()));
 
             if (mit != mAcquired.end ())
-                ourVote = mit->second->hasItem (txID);
+                ourVote = setHasTransaction (mit->second, txID);
             else
                 assert (false); // We don't have our own position?
         }
@@ -1211,7 +1353,8 @@ private:
 
             if ((cit != mAcquired.end ()) && cit->second)
             {
-                txn->setVote (pit.first, cit->second->hasItem (txID));
+                txn->setVote (pit.first,
+                    setHasTransaction (cit->second, txID));
             }
         }
 
@@ -1239,7 +1382,8 @@ private:
     {
         for (auto& it : mDisputes)
         {
-            bool setHas = map->hasItem (it.second->getTransactionID ());
+            bool setHas = setHasTransaction (map,
+                it.second->getTransactionID ());
 
             for (auto const& pit : peers)
                 it.second->setVote (pit, setHas);
@@ -1753,6 +1897,8 @@ private:
         }
 
         getApp().getOPs ().newLCL (mPeerPositions.size (), mCurrentMSeconds, mNewLedgerHash);
+        getApp().getOPs ().getLedgerTiming ().onConverge (
+            mCurrentMSeconds, mPeerPositions.size (), mConsensusFail);
 
         if (synchronous)
         {
@@ -1824,6 +1970,13 @@ private:
     hash_map<uint256, DisputedTx::pointer> mDisputes;
     hash_set<uint256> mCompares;
 
+    // Cached differences of each transaction set from the diff base
+    std::shared_ptr<SHAMap> mDiffBase;
+    hash_map<uint256, std::unique_ptr<hash_set<uint256>>> mSetDiffs;
+
+    // Whether the diff base contains each disputed transaction
+    hash_map<uint256, bool> mBaseHas;
+
     // Close time estimates
     std::map<std::uint32_t, int> mCloseTimes;
 
@@ -1919,6 +2072,56 @@ int applyTransaction (TransactionEngine& engine,
     }
 }
 
+// Candidate sets smaller than this are prepared on the calling thread
+enum
+{
+    preparePerJobMin = 64,
+    prepareJobsMax = 8
+};
+
+/** Deserialize candidate transactions and check their signatures
+
+  Checking signatures is most of the cost of applying a set and does not
+  depend on the ledger, so it is spread over several threads. Each
+  transaction caches the result of its check, and the transactions are
+  still applied one at a time in canonical order, so the ledger built is
+  the same.
+
+  @param items   The candidate transactions, in the order they are applied
+  @return        The transactions, with null for any that failed to parse
+*/
+static
+std::vector<STTx::pointer>
+prepareTransactions (std::vector<std::shared_ptr<SHAMapItem>> const& items)
+{
+    std::vector<STTx::pointer> txns (items.size ());
+
+    parallelFor (getApp().getJobQueue (), jtACCEPT, "prepareTransactions",
+        items.size (), preparePerJobMin, prepareJobsMax,
+        [&items, &txns] (std::size_t i)
+        {
+            try
+            {
+                SerialIter sit (items[i]->peekSerializer ());
+                auto txn = getApp().getMasterTransaction ().parse (
+                    items[i]->getTag (), sit);
+
+                // The result is cached, a bad signature fails during apply
+                if ((getApp().getHashRouter ().getFlags (
+                        txn->getTransactionID ()) & SF_SIGGOOD) != SF_SIGGOOD)
+                    txn->checkSign ();
+
+                txns[i] = std::move (txn);
+            }
+            catch (...)
+            {
+                WriteLog (lsWARNING, LedgerConsensus) << "  Throws";
+            }
+        });
+
+    return txns;
+}
+
 /** Apply a set of transactions to a ledger
 
   @param set                   The set of transactions to apply
@@ -1928,43 +2131,58 @@ int applyTransaction (TransactionEngine& engine,
                                messages (typically new last closed ledger).
   @param retriableTransactions collect failed transactions in this set
   @param openLgr               true if applyLedger is open, else false.
+  @param skip                  Transactions in set that were already applied
+                               to applyLedger, may be null.
 */
 void applyTransactions (std::shared_ptr<SHAMap> const& set,
                         Ledger::ref applyLedger, 
                         Ledger::ref checkLedger,
                         CanonicalTXSet& retriableTransactions,
-                        bool openLgr)
+                        bool openLgr,
+                        std::shared_ptr<SHAMap> const& skip)
 {
     TransactionEngine engine (applyLedger);
 
     if (set)
     {
+        std::vector<std::shared_ptr<SHAMapItem>> items;
+
         for (std::shared_ptr<SHAMapItem> item = set->peekFirstItem (); 
             !!item;
             item = set->peekNextItem (item->getTag ()))
         {
+            // Skip transactions that were already applied from skip
+            if (skip && skip->hasItem (item->getTag ()))
+                continue;
+
             // If the checkLedger doesn't have the transaction
             if (!checkLedger->hasTransaction (item->getTag ()))
-            {
-                // Then try to apply the transaction to applyLedger
-                WriteLog (lsDEBUG, LedgerConsensus) << "Processing candidate transaction: " << item->getTag ();
+                items.push_back (item);
+        }
 
-                try
-                {
-                    SerialIter    sit (item->peekSerializer ());
-                    STTx::pointer txn = std::make_shared<STTx>(sit);
-                    if (applyTransaction (engine, txn, openLgr, true) == LedgerConsensusImp::resultRetry)
-                    {
-                        // On failure, stash the failed transaction for
-                        // later retry.
-                        retriableTransactions.push_back (txn);
-                    }
-                }
-                catch (...)
+        auto const txns = prepareTransactions (items);
+
+        for (std::size_t i = 0; i < items.size (); ++i)
+        {
+            // Then try to apply the transaction to applyLedger
+            WriteLog (lsDEBUG, LedgerConsensus) << "Processing candidate transaction: " << items[i]->getTag ();
+
+            if (!txns[i])
+                continue;
+
+            try
+            {
+                if (applyTransaction (engine, txns[i], openLgr, true) == LedgerConsensusImp::resultRetry)
                 {
-                    WriteLog (lsWARNING, LedgerConsensus) << "  Throws";
+                    // On failure, stash the failed transaction for
+                    // later retry.
+                    retriableTransactions.push_back (txns[i]);
                 }
             }
+            catch (...)
+            {
+                WriteLog (lsWARNING, LedgerConsensus) << "  Throws";
+            }
         }
     }
 
@@ -86,7 +86,8 @@ applyTransactions(std::shared_ptr<SHAMap> const& set,
                   Ledger::ref applyLedger,
                   Ledger::ref checkLedger,
                   CanonicalTXSet& retriableTransactions,
-                  bool openLgr);
+                  bool openLgr,
+                  std::shared_ptr<SHAMap> const& skip = nullptr);
 
 } // skywell
 
@@ -43,7 +43,7 @@ AcceptedLedger::AcceptedLedger (Ledger::ref ledger) : mLedger (ledger)
     {
         SerialIter sit (item->peekSerializer ());
 
-        insert (std::make_shared<AcceptedLedgerTx> (ledger, std::ref (sit)));
+        insert (std::make_shared<AcceptedLedgerTx> (ledger, item->getTag (), std::ref (sit)));
     }
 }
 
@@ -20,20 +20,24 @@
 #include <BeastConfig.h>
 #include <ledger/AcceptedLedgerTx.h>
 #include <ledger/LedgerEntrySet.h>
+#include <main/Application.h>
+#include <transaction/tx/TransactionMaster.h>
 #include <common/base/StringUtilities.h>
 #include <protocol/JsonFields.h>
 
 namespace skywell {
 
-AcceptedLedgerTx::AcceptedLedgerTx (Ledger::ref ledger, SerialIter& sit)
+AcceptedLedgerTx::AcceptedLedgerTx (Ledger::ref ledger,
+                                    uint256 const& txID,
+                                    SerialIter& sit)
     : mLedger (ledger)
 {
     Serializer  txnSer (sit.getVL ());
     SerialIter  txnIt (txnSer);
 
-	mTxn = std::make_shared<STTx>(std::ref(txnIt));
+    mTxn = getApp().getMasterTransaction ().parse (txID, txnIt);
     mRawMeta  =  sit.getVL ();
-    mMeta     =  std::make_shared<TransactionMetaSet> (mTxn->getTransactionID (), ledger->getLedgerSeq (), mRawMeta);
+    mMeta     =  std::make_shared<TransactionMetaSet> (txID, ledger->getLedgerSeq (), mRawMeta);
     mAffected = mMeta->getAffectedAccounts ();
     mResult   =   mMeta->getResultTER ();
 
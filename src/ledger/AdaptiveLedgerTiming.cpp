@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <ledger/AdaptiveLedgerTiming.h>
+#include <ledger/LedgerTiming.h>
+#include <protocol/JsonFields.h>
+#include <algorithm>
+
+namespace skywell {
+
+// Each new measurement moves the smoothed value 1/4 of the way
+static int smooth (int average, int sample)
+{
+    return average + (sample - average) / 4;
+}
+
+AdaptiveLedgerTiming::AdaptiveLedgerTiming (Setup const& setup,
+    beast::insight::Collector::ptr const& collector, beast::Journal journal)
+    : setup_ (setup)
+    , journal_ (journal)
+    , applyTime_ (0)
+    , convergeTime_ (LEDGER_MIN_CONSENSUS)
+    , proposeDelay_ (0)
+    , roundDelay_ (0)
+    , roundProposers_ (0)
+    , roundFailed_ (false)
+    , lastProposers_ (0)
+    , closeInterval_ (setup.close_max)
+    , minConsensus_ (LEDGER_MIN_CONSENSUS)
+    , closeIntervalGauge_ (collector->make_gauge ("ledger_timing", "close_interval"))
+    , minConsensusGauge_ (collector->make_gauge ("ledger_timing", "min_consensus"))
+    , applyTimeGauge_ (collector->make_gauge ("ledger_timing", "apply"))
+    , convergeTimeGauge_ (collector->make_gauge ("ledger_timing", "converge"))
+    , proposeDelayGauge_ (collector->make_gauge ("ledger_timing", "propose_delay"))
+{
+}
+
+void
+AdaptiveLedgerTiming::onProposal (int delay)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+
+    roundDelay_ = std::max (roundDelay_, delay);
+}
+
+void
+AdaptiveLedgerTiming::onConverge (int convergeTime, int proposers, bool failed)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+
+    convergeTime_ = smooth (convergeTime_, convergeTime);
+    roundProposers_ = proposers;
+    roundFailed_ = failed;
+}
+
+void
+AdaptiveLedgerTiming::onAccept (int applyTime)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+
+    applyTime_ = smooth (applyTime_, applyTime);
+    proposeDelay_ = smooth (proposeDelay_, roundDelay_);
+
+    update ();
+
+    lastProposers_ = roundProposers_;
+    roundDelay_ = 0;
+    roundFailed_ = false;
+}
+
+int
+AdaptiveLedgerTiming::getCloseInterval () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return closeInterval_;
+}
+
+int
+AdaptiveLedgerTiming::getMinConsensus () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return minConsensus_;
+}
+
+Json::Value
+AdaptiveLedgerTiming::getJson () const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+
+    Json::Value ret (Json::objectValue);
+
+    ret[jss::adaptive] = setup_.adaptive;
+    ret[jss::close_interval] = closeInterval_;
+    ret[jss::min_consensus] = minConsensus_;
+    ret[jss::apply_time] = applyTime_;
+    ret[jss::converge_time] = convergeTime_;
+    ret[jss::propose_delay] = proposeDelay_;
+
+    return ret;
+}
+
+void
+AdaptiveLedgerTiming::update ()
+{
+    bool const stressed = roundFailed_ || (roundProposers_ < lastProposers_);
+
+    if (setup_.adaptive)
+    {
+        // Leave the network time to apply and agree on each ledger twice
+        // over. Close times have a resolution of a second, so round up.
+        int target = 2 * (applyTime_ + convergeTime_);
+        target = ((target + LEDGER_GRANULARITY - 1) / LEDGER_GRANULARITY)
+            * LEDGER_GRANULARITY;
+        target = std::max (setup_.close_min, std::min (setup_.close_max, target));
+
+        if (stressed)
+            closeInterval_ = setup_.close_max;
+        else if (target >= closeInterval_)
+            closeInterval_ = target;
+        else
+            closeInterval_ = std::max (target, closeInterval_ - LEDGER_GRANULARITY);
+
+        // Wait for the slowest initial positions with some margin, but
+        // never longer than the fixed minimum
+        minConsensus_ = stressed ? LEDGER_MIN_CONSENSUS : std::max (
+            setup_.consensus_min, std::min (LEDGER_MIN_CONSENSUS, 3 * proposeDelay_));
+    }
+
+    if (journal_.info) journal_.info <<
+        "Close interval " << closeInterval_ <<
+        "ms, min consensus " << minConsensus_ <<
+        "ms (apply " << applyTime_ <<
+        "ms, converge " << convergeTime_ <<
+        "ms, propose delay " << proposeDelay_ <<
+        "ms, proposers " << roundProposers_ << "/" << lastProposers_ <<
+        (roundFailed_ ? ", failed" : "") << ")";
+
+    closeIntervalGauge_ = closeInterval_;
+    minConsensusGauge_ = minConsensus_;
+    applyTimeGauge_ = applyTime_;
+    convergeTimeGauge_ = convergeTime_;
+    proposeDelayGauge_ = proposeDelay_;
+}
+
+AdaptiveLedgerTiming::Setup
+setup_AdaptiveLedgerTiming (Section const& section)
+{
+    AdaptiveLedgerTiming::Setup setup;
+    set (setup.adaptive, "adaptive", section);
+    set (setup.close_min, "close_min", section);
+    set (setup.close_max, "close_max", section);
+    set (setup.consensus_min, "consensus_min", section);
+
+    // Keep the bounds sane whatever the config says
+    setup.close_min = std::max (setup.close_min, LEDGER_MIN_CLOSE);
+    setup.close_max = std::max (setup.close_max, setup.close_min);
+    setup.consensus_min = std::max (LEDGER_GRANULARITY,
+        std::min (setup.consensus_min, LEDGER_MIN_CONSENSUS));
+    return setup;
+}
+
+} // skywell
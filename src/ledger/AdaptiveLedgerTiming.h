@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_LEDGER_ADAPTIVELEDGERTIMING_H_INCLUDED
+#define SKYWELL_APP_LEDGER_ADAPTIVELEDGERTIMING_H_INCLUDED
+
+#include <common/base/BasicConfig.h>
+#include <common/json/json_value.h>
+#include <beast/Insight.h>
+#include <beast/utility/Journal.h>
+#include <mutex>
+
+namespace skywell {
+
+/** Tunes the ledger close interval from measured consensus timings.
+
+    Each round reports how long peers' initial positions took to arrive
+    after we closed, how long the round took to converge and how long
+    accepting the ledger took. From the smoothed measurements this picks
+    the close interval and the minimum time we wait for initial
+    positions, always within the configured bounds. A failed round, or
+    a round with fewer proposers than the last, moves straight back to
+    the longest interval, which then shortens one step per good round.
+
+    With adaptive timing off the fixed intervals are used, but the
+    measurements are still tracked and reported.
+*/
+class AdaptiveLedgerTiming
+{
+public:
+    /** Bounds on the timing, in milliseconds.
+        A default-constructed Setup keeps the fixed timing.
+    */
+    struct Setup
+    {
+        /** Whether to tune the timing at all. */
+        bool adaptive = false;
+
+        /** The shortest close interval. */
+        int close_min = 2000;
+
+        /** The longest close interval, and the fixed one. */
+        int close_max = 5000;
+
+        /** The shortest wait for initial positions. */
+        int consensus_min = 1000;
+    };
+
+    AdaptiveLedgerTiming (Setup const& setup,
+        beast::insight::Collector::ptr const& collector,
+            beast::Journal journal);
+
+    AdaptiveLedgerTiming (AdaptiveLedgerTiming const&) = delete;
+    AdaptiveLedgerTiming& operator= (AdaptiveLedgerTiming const&) = delete;
+
+    /** A peer's initial position arrived this long after we closed. */
+    void
+    onProposal (int delay);
+
+    /** The round reached consensus, or gave up, after this long. */
+    void
+    onConverge (int convergeTime, int proposers, bool failed);
+
+    /** Accepting the ledger took this long, which ends the round. */
+    void
+    onAccept (int applyTime);
+
+    /** How long a ledger stays open, in milliseconds. */
+    int
+    getCloseInterval () const;
+
+    /** How long we wait for initial positions, in milliseconds. */
+    int
+    getMinConsensus () const;
+
+    Json::Value
+    getJson () const;
+
+private:
+    void
+    update ();
+
+    Setup const setup_;
+    beast::Journal journal_;
+
+    std::mutex mutable mutex_;
+
+    // Smoothed measurements
+    int applyTime_;
+    int convergeTime_;
+    int proposeDelay_;
+
+    // The current round
+    int roundDelay_;
+    int roundProposers_;
+    bool roundFailed_;
+
+    int lastProposers_;
+
+    // Decisions
+    int closeInterval_;
+    int minConsensus_;
+
+    beast::insight::Gauge closeIntervalGauge_;
+    beast::insight::Gauge minConsensusGauge_;
+    beast::insight::Gauge applyTimeGauge_;
+    beast::insight::Gauge convergeTimeGauge_;
+    beast::insight::Gauge proposeDelayGauge_;
+};
+
+/** Build AdaptiveLedgerTiming::Setup from a config section. */
+AdaptiveLedgerTiming::Setup
+setup_AdaptiveLedgerTiming (Section const& section);
+
+} // skywell
+
+#endif
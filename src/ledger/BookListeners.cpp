@@ -24,26 +24,48 @@
 
 namespace skywell {
 
-void BookListeners::addSubscriber (InfoSub::ref sub)
+void BookListeners::addSubscriber (InfoSub::ref sub, bool delta)
 {
     ScopedLockType sl (mLock);
-    mListeners[sub->getSeq ()] = sub;
+
+    if (delta)
+        mDeltaListeners[sub->getSeq ()] = sub;
+    else
+        mListeners[sub->getSeq ()] = sub;
 }
 
 void BookListeners::removeSubscriber (std::uint64_t seq)
 {
     ScopedLockType sl (mLock);
     mListeners.erase (seq);
+    mDeltaListeners.erase (seq);
 }
 
 void BookListeners::publish (Json::Value const& jvObj)
+{
+    send (mListeners, jvObj);
+}
+
+void BookListeners::publishDelta (Json::Value const& jvObj)
+{
+    send (mDeltaListeners, jvObj);
+}
+
+bool BookListeners::wantsDeltas ()
+{
+    ScopedLockType sl (mLock);
+    return !mDeltaListeners.empty ();
+}
+
+void BookListeners::send (hash_map<std::uint64_t, InfoSub::wptr>& listeners,
+    Json::Value const& jvObj)
 {
     std::string sObj = to_string (jvObj);
 
     ScopedLockType sl (mLock);
-    NetworkOPs::SubMapType::const_iterator it = mListeners.begin ();
+    NetworkOPs::SubMapType::const_iterator it = listeners.begin ();
 
-    while (it != mListeners.end ())
+    while (it != listeners.end ())
     {
         InfoSub::pointer p = it->second.lock ();
 
@@ -54,7 +76,7 @@ void BookListeners::publish (Json::Value const& jvObj)
          }
         else
         {
-            it = mListeners.erase (it);
+            it = listeners.erase (it);
         }
     }
 }
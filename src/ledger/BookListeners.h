@@ -25,7 +25,11 @@
 
 namespace skywell {
 
-/** Listen to public/subscribe messages from a book. */
+/** Listen to public/subscribe messages from a book.
+
+    Delta listeners get one message per ledger with the book's offers that
+    were created, changed or removed, instead of every transaction.
+*/
 class BookListeners
 {
 public:
@@ -33,9 +37,12 @@ public:
 
     BookListeners () {}
 
-    void addSubscriber (InfoSub::ref sub);
+    void addSubscriber (InfoSub::ref sub, bool delta);
     void removeSubscriber (std::uint64_t sub);
     void publish (Json::Value const& jvObj);
+    void publishDelta (Json::Value const& jvObj);
+
+    bool wantsDeltas ();
 
 private:
     typedef SkywellRecursiveMutex LockType;
@@ -43,6 +50,10 @@ private:
     LockType mLock;
 
     hash_map<std::uint64_t, InfoSub::wptr> mListeners;
+    hash_map<std::uint64_t, InfoSub::wptr> mDeltaListeners;
+
+    void send (hash_map<std::uint64_t, InfoSub::wptr>& listeners,
+        Json::Value const& jvObj);
 };
 
 } // skywell
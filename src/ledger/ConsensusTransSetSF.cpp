@@ -54,7 +54,7 @@ void ConsensusTransSetSF::gotNode (bool fromFilter,
         {
             Serializer s (nodeData.begin () + 4, nodeData.end ()); // skip prefix
             SerialIter sit (s);
-            STTx::pointer stx = std::make_shared<STTx> (std::ref (sit));
+            STTx::pointer stx = getApp().getMasterTransaction ().parse (nodeHash, sit);
 
             assert (stx->getTransactionID () == nodeHash);
 
@@ -33,6 +33,7 @@
 #include <protocol/HashPrefix.h>
 #include <protocol/JsonFields.h>
 #include <data/nodestore/Database.h>
+#include <algorithm>
 
 namespace skywell {
 
@@ -55,6 +56,21 @@ enum
 
     // How many nodes to consider a fetch "small"
     ,fetchSmallNodes = 32
+
+    // How many missing nodes to look for per peer we fetch from
+    ,missingNodesMax = 256
+
+    // How many nodes to request from a single peer at once
+    ,filterNodesMax = 128
+
+    // Most peers a fetch of missing nodes is partitioned across
+    ,partitionPeersMax = 6
+
+    // Most requests we keep outstanding to a single peer
+    ,peerPipelineDepth = 3
+
+    // Latency we assume for a peer we have no replies from yet
+    ,unknownPeerLatencyMillis = 500
 };
 
 InboundLedger::InboundLedger (uint256 const& hash, std::uint32_t seq, fcReason reason, clock_type& clock)
@@ -292,6 +308,20 @@ void InboundLedger::onTimer (bool wasProgress, ScopedLockType&)
 
     if (!wasProgress)
     {
+        // Requests that went unanswered for a whole interval are lost,
+        // make sure the peers they went to don't look fast.
+        for (auto& entry : mPeerStats)
+        {
+            PeerStats& stats = entry.second;
+
+            if (!stats.outstanding.empty ())
+            {
+                stats.outstanding.clear ();
+                stats.latency = std::max<int> (
+                    stats.latency, ledgerAcquireTimeoutMillis);
+            }
+        }
+
         checkLocal();
 
         mAggressive = true;
@@ -561,17 +591,20 @@ void InboundLedger::trigger (Peer::ptr const& peer)
         }
         else
         {
+            // When we ask all our peers, find enough missing nodes to
+            // give each of them a different part of the tree.
+            int const partitions = getPartitionCount (peer);
+
             std::vector<SHAMapNodeID> nodeIDs;
             std::vector<uint256> nodeHashes;
-            //  Why 256? Make this a constant
-            nodeIDs.reserve (256);
-            nodeHashes.reserve (256);
+            nodeIDs.reserve (missingNodesMax * partitions);
+            nodeHashes.reserve (missingNodesMax * partitions);
             AccountStateSF filter;
 
             // Release the lock while we process the large state map
             sl.unlock();
             mLedger->peekAccountStateMap ()->getMissingNodes (
-                nodeIDs, nodeHashes, 256, &filter);
+                nodeIDs, nodeHashes, missingNodesMax * partitions, &filter);
             sl.lock();
 
             // Make sure nothing happened while we released the lock
@@ -591,22 +624,13 @@ void InboundLedger::trigger (Peer::ptr const& peer)
                 }
                 else
                 {
-                    //  Why 128? Make this a constant
                     if (!mAggressive)
-                        filterNodes (nodeIDs, nodeHashes, 128, !isProgress ());
+                        filterNodes (nodeIDs, nodeHashes,
+                            filterNodesMax * partitions, !isProgress ());
 
                     if (!nodeIDs.empty ())
                     {
                         tmGL.set_itype (protocol::liAS_NODE);
-                        for (auto const& id : nodeIDs)
-                        {
-                            * (tmGL.add_nodeids ()) = id.getRawString ();
-                        }
-
-                        // If we're not querying for a lot of entries,
-                        // query extra deep
-                        if (nodeIDs.size() <= fetchSmallNodes)
-                            tmGL.set_querydepth (tmGL.querydepth() + 1);
 
                         if (m_journal.trace) 
                             m_journal.trace << "Sending AS node "
@@ -617,7 +641,7 @@ void InboundLedger::trigger (Peer::ptr const& peer)
                         if (nodeIDs.size () == 1 && m_journal.trace) 
                             m_journal.trace << "AS node: " << nodeIDs[0];
 
-                        sendRequest (tmGL, peer);
+                        sendNodeRequest (tmGL, nodeIDs, peer);
 
                         return;
                     }
@@ -654,13 +678,16 @@ void InboundLedger::trigger (Peer::ptr const& peer)
         }
         else
         {
+            int const partitions = getPartitionCount (peer);
+
             std::vector<SHAMapNodeID> nodeIDs;
             std::vector<uint256> nodeHashes;
-            nodeIDs.reserve (256);
-            nodeHashes.reserve (256);
+            nodeIDs.reserve (missingNodesMax * partitions);
+            nodeHashes.reserve (missingNodesMax * partitions);
             TransactionStateSF filter;
 
-            mLedger->peekTransactionMap ()->getMissingNodes (nodeIDs, nodeHashes, 256, &filter);
+            mLedger->peekTransactionMap ()->getMissingNodes (nodeIDs,
+                nodeHashes, missingNodesMax * partitions, &filter);
 
             if (nodeIDs.empty ())
             {
@@ -677,20 +704,17 @@ void InboundLedger::trigger (Peer::ptr const& peer)
             else
             {
                 if (!mAggressive)
-                    filterNodes (nodeIDs, nodeHashes, 128, !isProgress ());
+                    filterNodes (nodeIDs, nodeHashes,
+                        filterNodesMax * partitions, !isProgress ());
 
                 if (!nodeIDs.empty ())
                 {
                     tmGL.set_itype (protocol::liTX_NODE);
-                    for (auto const& id : nodeIDs)
-                    {
-                        * (tmGL.add_nodeids ()) = id.getRawString ();
-                    }
                     if (m_journal.trace) m_journal.trace <<
                         "Sending TX node " << nodeIDs.size () <<
                         " request to " << (
                             peer ? "selected peer" : "all peers");
-                    sendRequest (tmGL, peer);
+                    sendNodeRequest (tmGL, nodeIDs, peer);
                     return;
                 }
                 else
@@ -711,6 +735,202 @@ void InboundLedger::trigger (Peer::ptr const& peer)
     }
 }
 
+int InboundLedger::getPartitionCount (Peer::ptr const& peer)
+{
+    // When aggressive we deliberately ask every peer for the same nodes
+    if (peer || mAggressive)
+        return 1;
+
+    std::size_t const pc = getPeerCount ();
+
+    return static_cast<int> (std::max<std::size_t> (1,
+        std::min<std::size_t> (pc, partitionPeersMax)));
+}
+
+std::vector<Peer::ptr> InboundLedger::getRankedPeers ()
+{
+    std::vector<Peer::ptr> ready;
+    std::vector<Peer::ptr> busy;
+
+    for (auto const& p : mPeers)
+    {
+        Peer::ptr peer (getApp().overlay ().findPeerByShortID (p.first));
+
+        if (!peer)
+            continue;
+
+        if (mPeerStats[p.first].outstanding.size () < peerPipelineDepth)
+            ready.push_back (peer);
+        else
+            busy.push_back (peer);
+    }
+
+    // Only fall back to peers with a full pipeline if we have to
+    if (ready.empty ())
+        ready.swap (busy);
+
+    auto latency = [this] (Peer::ptr const& peer)
+    {
+        PeerStats const& stats = mPeerStats[peer->id ()];
+        return (stats.samples == 0) ?
+            static_cast<int> (unknownPeerLatencyMillis) : stats.latency;
+    };
+
+    std::stable_sort (ready.begin (), ready.end (),
+        [&latency] (Peer::ptr const& a, Peer::ptr const& b)
+        {
+            return latency (a) < latency (b);
+        });
+
+    return ready;
+}
+
+void InboundLedger::sendNodeSlice (protocol::TMGetLedger const& tmGL,
+    std::vector<SHAMapNodeID>::const_iterator first,
+    std::vector<SHAMapNodeID>::const_iterator last,
+    Peer::ptr const& peer)
+{
+    protocol::TMGetLedger request (tmGL);
+
+    for (auto it = first; it != last; ++it)
+        * (request.add_nodeids ()) = it->getRawString ();
+
+    // If we're not querying for a lot of entries, query extra deep
+    if ((request.itype () == protocol::liAS_NODE) &&
+        (request.nodeids_size () <= fetchSmallNodes))
+    {
+        request.set_querydepth (request.querydepth () + 1);
+    }
+
+    mPeerStats[peer->id ()].outstanding.push_back (m_clock.now ());
+
+    peer->send (std::make_shared<Message> (request, protocol::mtGET_LEDGER));
+}
+
+void InboundLedger::sendNodeRequest (protocol::TMGetLedger const& tmGL,
+    std::vector<SHAMapNodeID> const& nodeIDs, Peer::ptr const& peer)
+{
+    if (nodeIDs.empty ())
+        return;
+
+    if (peer)
+    {
+        // Keep several requests in flight to a peer that is answering
+        // us, so it never sits idle while we process its last reply.
+        std::size_t const pending = std::min<std::size_t> (
+            mPeerStats[peer->id ()].outstanding.size (), peerPipelineDepth - 1);
+        std::size_t const slices = std::max<std::size_t> (1, std::min<std::size_t> (
+            peerPipelineDepth - pending, nodeIDs.size () / fetchSmallNodes));
+        std::size_t const size = (nodeIDs.size () + slices - 1) / slices;
+
+        for (std::size_t i = 0; i < nodeIDs.size (); i += size)
+        {
+            sendNodeSlice (tmGL, nodeIDs.begin () + i,
+                nodeIDs.begin () + std::min (i + size, nodeIDs.size ()), peer);
+        }
+
+        return;
+    }
+
+    std::vector<Peer::ptr> peers = getRankedPeers ();
+
+    if (peers.empty ())
+        return;
+
+    if (mAggressive)
+    {
+        // No progress, ask everyone for everything
+        for (auto const& p : peers)
+            sendNodeSlice (tmGL, nodeIDs.begin (), nodeIDs.end (), p);
+
+        return;
+    }
+
+    if (peers.size () > partitionPeersMax)
+        peers.resize (partitionPeersMax);
+
+    if (peers.size () > nodeIDs.size ())
+        peers.resize (nodeIDs.size ());
+
+    // Partition the missing nodes into contiguous runs, which keeps
+    // each peer in its own part of the tree. Faster peers get a
+    // larger share, in proportion to the inverse of their latency.
+    std::vector<double> weights;
+    weights.reserve (peers.size ());
+    double total = 0;
+
+    for (auto const& p : peers)
+    {
+        PeerStats const& stats = mPeerStats[p->id ()];
+        int const latency = (stats.samples == 0) ?
+            static_cast<int> (unknownPeerLatencyMillis) : stats.latency;
+        weights.push_back (1.0 / std::max (latency, 1));
+        total += weights.back ();
+    }
+
+    std::size_t first = 0;
+
+    for (std::size_t i = 0; i < peers.size (); ++i)
+    {
+        std::size_t const remaining = peers.size () - i - 1;
+        std::size_t count = (remaining == 0) ? (nodeIDs.size () - first) :
+            static_cast<std::size_t> (nodeIDs.size () * weights[i] / total);
+
+        // Every peer gets at least one node, and leaves one for the rest
+        count = std::max<std::size_t> (count, 1);
+        count = std::min (count, nodeIDs.size () - first - remaining);
+
+        if (m_journal.trace) m_journal.trace <<
+            "Partition " << count << " nodes to peer " << peers[i]->id ();
+
+        sendNodeSlice (tmGL, nodeIDs.begin () + first,
+            nodeIDs.begin () + first + count, peers[i]);
+        first += count;
+    }
+}
+
+// Whether a reply answers a node request sent by sendNodeSlice. Root
+// requests go through sendRequest, and are never tracked.
+static
+bool
+isNodeReply (protocol::TMLedgerData const& packet)
+{
+    if ((packet.type () != protocol::liAS_NODE) &&
+        (packet.type () != protocol::liTX_NODE))
+        return false;
+
+    if ((packet.nodes_size () == 0) || !packet.nodes (0).has_nodeid ())
+        return false;
+
+    return !SHAMapNodeID (packet.nodes (0).nodeid ().data (),
+        packet.nodes (0).nodeid ().size ()).isRoot ();
+}
+
+void InboundLedger::onPeerData (Peer::ptr const& peer, int useful,
+    bool nodeReply)
+{
+    ScopedLockType sl (mLock);
+
+    PeerStats& stats = mPeerStats[peer->id ()];
+
+    ++stats.received;
+
+    if (useful > 0)
+        stats.useful += useful;
+
+    // Header and root replies answer requests we never tracked
+    if (nodeReply && !stats.outstanding.empty ())
+    {
+        int const sample = static_cast<int> (
+            std::chrono::duration_cast <std::chrono::milliseconds> (
+                m_clock.now () - stats.outstanding.front ()).count ());
+        stats.outstanding.pop_front ();
+
+        stats.latency = (++stats.samples == 1) ?
+            sample : ((stats.latency * 3) + sample) / 4;
+    }
+}
+
 void InboundLedger::filterNodes (std::vector<SHAMapNodeID>& nodeIDs,
     std::vector<uint256>& nodeHashes, int max, bool aggressive)
 {
@@ -1205,12 +1425,13 @@ int InboundLedger::processData (std::shared_ptr<Peer> peer, protocol::TMLedgerDa
 }
 
 /** Process pending TMLedgerData
-    Query the 'best' peer
+    Query the 'best' peer, and keep the other useful peers busy
 */
 void InboundLedger::runData ()
 {
     std::shared_ptr<Peer> chosenPeer;
     int chosenPeerCount = -1;
+    std::vector<Peer::ptr> usefulPeers;
 
     std::vector <PeerDataPairType> data;
     do
@@ -1235,6 +1456,14 @@ void InboundLedger::runData ()
             if (peer)
             {
                 int count = processData (peer, *(entry.second));
+                onPeerData (peer, count, isNodeReply (*entry.second));
+
+                if ((count > 0) && (std::find (usefulPeers.begin (),
+                    usefulPeers.end (), peer) == usefulPeers.end ()))
+                {
+                    usefulPeers.push_back (peer);
+                }
+
                 if (count > chosenPeerCount)
                 {
                     chosenPeer = peer;
@@ -1247,6 +1476,13 @@ void InboundLedger::runData ()
 
     if (chosenPeer)
         trigger (chosenPeer);
+
+    // Each trigger asks for nodes not yet requested from anyone else
+    for (auto const& peer : usefulPeers)
+    {
+        if (peer != chosenPeer)
+            trigger (peer);
+    }
 }
 
 Json::Value InboundLedger::getJson (int)
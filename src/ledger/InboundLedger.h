@@ -20,6 +20,7 @@
 #ifndef SKYWELL_APP_LEDGER_INBOUNDLEDGER_H_INCLUDED
 #define SKYWELL_APP_LEDGER_INBOUNDLEDGER_H_INCLUDED
 
+#include <deque>
 #include <set>
 #include <ledger/Ledger.h>
 #include <network/overlay/PeerSet.h>
@@ -140,7 +141,57 @@ private:
                      SHAMapAddNode&);
     bool takeAsRootNode (Blob const& data, SHAMapAddNode&);
 
+    /** Send a node request, partitioning the nodes across our peers
+        when no specific peer is selected.
+        Call with a lock
+    */
+    void sendNodeRequest (protocol::TMGetLedger const& tmGL,
+        std::vector<SHAMapNodeID> const& nodeIDs, Peer::ptr const& peer);
+
+    /** Send one slice of node IDs to a single peer */
+    void sendNodeSlice (protocol::TMGetLedger const& tmGL,
+        std::vector<SHAMapNodeID>::const_iterator first,
+        std::vector<SHAMapNodeID>::const_iterator last,
+        Peer::ptr const& peer);
+
+    /** Peers we can send requests to, fastest first */
+    std::vector<Peer::ptr> getRankedPeers ();
+
+    /** Update the statistics of a peer that answered a request
+        Only replies to node requests below the root answer a request
+        we track as outstanding.
+    */
+    void onPeerData (Peer::ptr const& peer, int useful, bool nodeReply);
+
+    /** How many nodes to ask for when we are fetching from all peers */
+    int getPartitionCount (Peer::ptr const& peer);
+
 private:
+    // Acquisition statistics we track for each peer in the set
+    struct PeerStats
+    {
+        PeerStats ()
+            : received (0)
+            , useful (0)
+            , samples (0)
+            , latency (0)
+        {
+        }
+
+        // Send times of node requests we haven't seen a reply to
+        std::deque <clock_type::time_point> outstanding;
+
+        // Number of replies and useful nodes received
+        int received;
+        int useful;
+
+        // Number of node replies timed, and the decaying average of
+        // their latency in milliseconds
+        int samples;
+        int latency;
+    };
+
+
     Ledger::pointer    mLedger;
     bool               mHaveHeader;
     bool               mHaveState;
@@ -153,6 +204,8 @@ private:
 
     std::set <uint256> mRecentNodes;
 
+    hash_map <Peer::id_t, PeerStats> mPeerStats;
+
     // Data we have received from peers
     PeerSet::LockType mReceivedDataLock;
     std::vector <PeerDataPairType> mReceivedData;
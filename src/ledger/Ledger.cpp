@@ -507,13 +507,13 @@ STTx::pointer Ledger::getSTransaction (std::shared_ptr<SHAMapItem> const& item,
     SerialIter sit (item->peekSerializer ());
 
     if (type == SHAMapTreeNode::tnTRANSACTION_NM)
-        return std::make_shared<STTx> (sit);
+        return getApp().getMasterTransaction ().parse (item->getTag (), sit);
 
     if (type == SHAMapTreeNode::tnTRANSACTION_MD)
     {
         Serializer sTxn (sit.getVL ());
         SerialIter tSit (sTxn);
-        return std::make_shared<STTx> (tSit);
+        return getApp().getMasterTransaction ().parse (item->getTag (), tSit);
     }
 
     return STTx::pointer ();
@@ -528,7 +528,7 @@ STTx::pointer Ledger::getSMTransaction (std::shared_ptr<SHAMapItem> const& item,
     if (type == SHAMapTreeNode::tnTRANSACTION_NM)
     {
         txMeta.reset ();
-        return std::make_shared<STTx> (sit);
+        return getApp().getMasterTransaction ().parse (item->getTag (), sit);
     }
     else if (type == SHAMapTreeNode::tnTRANSACTION_MD)
     {
@@ -537,7 +537,7 @@ STTx::pointer Ledger::getSMTransaction (std::shared_ptr<SHAMapItem> const& item,
 
         txMeta = std::make_shared<TransactionMetaSet> (item->getTag (), mLedgerSeq, sit.getVL ());
 
-        return std::make_shared<STTx> (tSit);
+        return getApp().getMasterTransaction ().parse (item->getTag (), tSit);
     }
 
     txMeta.reset ();
@@ -26,6 +26,7 @@
 #include <ledger/DeferredCredits.h>
 #include <protocol/JsonFields.h>
 #include <protocol/Indexes.h>
+#include <algorithm>
 
 namespace skywell {
 
@@ -36,12 +37,97 @@ namespace skywell {
 //
 #define DIR_NODE_MAX        32
 
+// Shared layers are collapsed into one when there are more than this many,
+// so that lookups through a long chain of duplicates stay cheap.
+#define LAYER_DEPTH_MAX     8
+
+static
+bool
+indexLess (LedgerEntrySet::value_type const& entry, uint256 const& index)
+{
+    return entry.first < index;
+}
+
+static
+bool
+indexGreater (uint256 const& index, LedgerEntrySet::value_type const& entry)
+{
+    return index < entry.first;
+}
+
+static
+LedgerEntrySet::Entries::const_iterator
+findIndex (LedgerEntrySet::Entries const& entries, uint256 const& index)
+{
+    auto const it = std::lower_bound (
+        entries.begin (), entries.end (), index, indexLess);
+
+    if ((it != entries.end ()) && (it->first == index))
+        return it;
+
+    return entries.end ();
+}
+
+// Walks the entries of a set in index order, across its changes and each
+// shared layer. Where several hold the same index, the newest one wins.
+// Erased entries are returned with an action of taaNONE.
+class LedgerEntrySet::Merge
+{
+public:
+    Merge (Entries const& top, Layer const* base, uint256 const* after = nullptr)
+    {
+        add (top, after);
+
+        for (; base != nullptr; base = base->parent.get ())
+            add (base->entries, after);
+    }
+
+    // Returns the next entry, or null when there are no more
+    value_type const*
+    next ()
+    {
+        value_type const* best = nullptr;
+
+        for (auto const& r : ranges_)
+        {
+            if ((r.first != r.second) &&
+                    ((best == nullptr) || (r.first->first < best->first)))
+                best = &*r.first;
+        }
+
+        if (best != nullptr)
+        {
+            for (auto& r : ranges_)
+            {
+                if ((r.first != r.second) && (r.first->first == best->first))
+                    ++r.first;
+            }
+        }
+
+        return best;
+    }
+
+private:
+    void
+    add (Entries const& entries, uint256 const* after)
+    {
+        auto const first = (after == nullptr) ? entries.begin () :
+            std::upper_bound (entries.begin (), entries.end (), *after, indexGreater);
+
+        ranges_.emplace_back (first, entries.end ());
+    }
+
+    std::vector<std::pair<
+        Entries::const_iterator, Entries::const_iterator>> ranges_;
+};
+
 void LedgerEntrySet::init (Ledger::ref ledger, 
                            uint256 const& transactionID,
                            std::uint32_t ledgerID, 
                            TransactionEngineParams params)
 {
     mEntries.clear ();
+    mBase.reset ();
     if (mDeferredCredits)
         mDeferredCredits->clear ();
 
@@ -54,15 +140,42 @@ void LedgerEntrySet::init (Ledger::ref ledger,
 void LedgerEntrySet::clear ()
 {
     mEntries.clear ();
+    mBase.reset ();
     mSet.clear ();
 
     if (mDeferredCredits)
         mDeferredCredits->clear ();
 }
 
+// The entries are not copied: both sets share them as an immutable layer
+// and copy an entry up only when they change it.
+LedgerEntrySet LedgerEntrySet::duplicate ()
+{
+    freeze ();
+    return LedgerEntrySet (mLedger, mBase, mSet, mSeq + 1, mDeferredCredits);
+}
+
 LedgerEntrySet LedgerEntrySet::duplicate () const
 {
-    return LedgerEntrySet (mLedger, mEntries, mSet, mSeq + 1, mDeferredCredits);
+    // Const members never rearrange the set, so concurrent readers are safe
+    if (mEntries.empty ())
+        return LedgerEntrySet (mLedger, mBase, mSet, mSeq + 1, mDeferredCredits);
+
+    return LedgerEntrySet (mLedger, makeLayer (mEntries, mBase), mSet,
+        mSeq + 1, mDeferredCredits);
+}
+
+bool LedgerEntrySet::empty () const
+{
+    Merge merge (mEntries, mBase.get ());
+
+    while (auto const entry = merge.next ())
+    {
+        if (entry->second.mAction != taaNONE)
+            return false;
+    }
+
+    return true;
 }
 
 void LedgerEntrySet::swapWith (LedgerEntrySet& e)
@@ -70,34 +183,163 @@ void LedgerEntrySet::swapWith (LedgerEntrySet& e)
     using std::swap;
     swap (mLedger, e.mLedger);
     mEntries.swap (e.mEntries);
+    swap (mBase, e.mBase);
     mSet.swap (e.mSet);
     swap (mParams, e.mParams);
     swap (mSeq, e.mSeq);
     swap (mDeferredCredits, e.mDeferredCredits);
 }
 
+LedgerEntrySetEntry* LedgerEntrySet::find (uint256 const& index)
+{
+    auto it = std::lower_bound (
+        mEntries.begin (), mEntries.end (), index, indexLess);
+
+    if ((it != mEntries.end ()) && (it->first == index))
+        return (it->second.mAction == taaNONE) ? nullptr : &it->second;
+
+    for (auto layer = mBase.get (); layer != nullptr; layer = layer->parent.get ())
+    {
+        auto const found = findIndex (layer->entries, index);
+
+        if (found == layer->entries.end ())
+            continue;
+
+        if (found->second.mAction == taaNONE)
+            return nullptr;
+
+        // Copy the entry up so that changes to it stay in this set
+        return &mEntries.insert (it, *found)->second;
+    }
+
+    return nullptr;
+}
+
+LedgerEntrySetEntry const* LedgerEntrySet::peek (uint256 const& index) const
+{
+    auto it = findIndex (mEntries, index);
+
+    if (it != mEntries.end ())
+        return (it->second.mAction == taaNONE) ? nullptr : &it->second;
+
+    for (auto layer = mBase.get (); layer != nullptr; layer = layer->parent.get ())
+    {
+        it = findIndex (layer->entries, index);
+
+        if (it != layer->entries.end ())
+            return (it->second.mAction == taaNONE) ? nullptr : &it->second;
+    }
+
+    return nullptr;
+}
+
+void LedgerEntrySet::insert (uint256 const& index, LedgerEntrySetEntry const& entry)
+{
+    auto it = std::lower_bound (
+        mEntries.begin (), mEntries.end (), index, indexLess);
+
+    // This may replace a marker left by erase
+    if ((it != mEntries.end ()) && (it->first == index))
+        it->second = entry;
+    else
+        mEntries.insert (it, value_type (index, entry));
+}
+
+void LedgerEntrySet::erase (uint256 const& index)
+{
+    auto it = std::lower_bound (
+        mEntries.begin (), mEntries.end (), index, indexLess);
+
+    assert ((it != mEntries.end ()) && (it->first == index));
+
+    // A shared layer may still hold the entry, so leave a marker to hide it
+    if (mBase)
+        it->second = LedgerEntrySetEntry (SLE::pointer (), taaNONE, mSeq);
+    else
+        mEntries.erase (it);
+}
+
+std::shared_ptr<LedgerEntrySet::Layer const>
+LedgerEntrySet::makeLayer (
+    Entries entries, std::shared_ptr<Layer const> const& parent)
+{
+    auto layer = std::make_shared<Layer> ();
+    layer->parent = parent;
+    layer->depth = parent ? (parent->depth + 1) : 1;
+    layer->entries.swap (entries);
+
+    if (layer->depth > LAYER_DEPTH_MAX)
+    {
+        Entries merged;
+        merged.reserve (layer->entries.size () + layer->parent->entries.size ());
+
+        Merge merge (layer->entries, layer->parent.get ());
+
+        while (auto const entry = merge.next ())
+        {
+            if (entry->second.mAction != taaNONE)
+                merged.push_back (*entry);
+        }
+
+        layer->entries.swap (merged);
+        layer->parent.reset ();
+        layer->depth = 1;
+    }
+
+    return layer;
+}
+
+void LedgerEntrySet::freeze ()
+{
+    if (mEntries.empty ())
+        return;
+
+    mBase = makeLayer (std::move (mEntries), mBase);
+    mEntries.clear ();
+}
+
+void LedgerEntrySet::flatten ()
+{
+    if (!mBase)
+        return;
+
+    Entries merged;
+    merged.reserve (mEntries.size () + mBase->entries.size ());
+
+    Merge merge (mEntries, mBase.get ());
+
+    while (auto const entry = merge.next ())
+    {
+        if (entry->second.mAction != taaNONE)
+            merged.push_back (*entry);
+    }
+
+    mEntries.swap (merged);
+    mBase.reset ();
+}
+
 // Find an entry in the set.  If it has the wrong sequence number, copy it and update the sequence number.
 // This is basically: copy-on-read.
 SLE::pointer LedgerEntrySet::getEntry (uint256 const& index, LedgerEntryAction& action)
 {
-    auto it = mEntries.find (index);
+    auto const entry = find (index);
 
-    if (it == mEntries.end ())
+    if (entry == nullptr)
     {
         action = taaNONE;
         return SLE::pointer ();
     }
 
-    if (it->second.mSeq != mSeq)
+    if (entry->mSeq != mSeq)
     {
-        assert (it->second.mSeq < mSeq);
-        it->second.mEntry = std::make_shared<STLedgerEntry> (*it->second.mEntry);
-        it->second.mSeq = mSeq;
+        assert (entry->mSeq < mSeq);
+        entry->mEntry = std::make_shared<STLedgerEntry> (*entry->mEntry);
+        entry->mSeq = mSeq;
     }
 
-    action = it->second.mAction;
+    action = entry->mAction;
 
-    return it->second.mEntry;
+    return entry->mEntry;
 }
 
 SLE::pointer LedgerEntrySet::entryCreate (LedgerEntryType letType, uint256 const& index)
@@ -140,20 +382,20 @@ void LedgerEntrySet::entryCache (SLE::ref sle)
 {
     assert (mLedger);
     assert (sle->isMutable () || mImmutable); // Don't put an immutable SLE in a mutable LES
-    auto it = mEntries.find (sle->getIndex ());
+    auto const entry = find (sle->getIndex ());
 
-    if (it == mEntries.end ())
+    if (entry == nullptr)
     {
-        mEntries.insert (std::make_pair (sle->getIndex (), LedgerEntrySetEntry (sle, taaCACHED, mSeq)));
+        insert (sle->getIndex (), LedgerEntrySetEntry (sle, taaCACHED, mSeq));
         return;
     }
 
-    switch (it->second.mAction)
+    switch (entry->mAction)
     {
     case taaCACHED:
-        assert (sle == it->second.mEntry);
-        it->second.mSeq     = mSeq;
-        it->second.mEntry   = sle;
+        assert (sle == entry->mEntry);
+        entry->mSeq     = mSeq;
+        entry->mEntry   = sle;
         return;
 
     default:
@@ -166,22 +408,22 @@ void LedgerEntrySet::entryCreate (SLE::ref sle)
     assert (mLedger && !mImmutable);
     assert (sle->isMutable ());
 
-    auto it = mEntries.find (sle->getIndex ());
+    auto const entry = find (sle->getIndex ());
 
-    if (it == mEntries.end ())
+    if (entry == nullptr)
     {
-        mEntries.insert (std::make_pair (sle->getIndex (), LedgerEntrySetEntry (sle, taaCREATE, mSeq)));
+        insert (sle->getIndex (), LedgerEntrySetEntry (sle, taaCREATE, mSeq));
         return;
     }
 
-    switch (it->second.mAction)
+    switch (entry->mAction)
     {
 
     case taaDELETE:
         WriteLog (lsDEBUG, LedgerEntrySet) << "Create after Delete = Modify";
-        it->second.mEntry = sle;
-        it->second.mAction = taaMODIFY;
-        it->second.mSeq = mSeq;
+        entry->mEntry = sle;
+        entry->mAction = taaMODIFY;
+        entry->mSeq = mSeq;
         break;
 
     case taaMODIFY:
@@ -197,35 +439,35 @@ void LedgerEntrySet::entryCreate (SLE::ref sle)
         throw std::runtime_error ("Unknown taa");
     }
 
-    assert (it->second.mSeq == mSeq);
+    assert (entry->mSeq == mSeq);
 }
 
 void LedgerEntrySet::entryModify (SLE::ref sle)
 {
     assert (sle->isMutable () && !mImmutable);
     assert (mLedger);
-    auto it = mEntries.find (sle->getIndex ());
+    auto const entry = find (sle->getIndex ());
 
-    if (it == mEntries.end ())
+    if (entry == nullptr)
     {
-        mEntries.insert (std::make_pair (sle->getIndex (), LedgerEntrySetEntry (sle, taaMODIFY, mSeq)));
+        insert (sle->getIndex (), LedgerEntrySetEntry (sle, taaMODIFY, mSeq));
         return;
     }
 
-    assert (it->second.mSeq == mSeq);
-    assert (it->second.mEntry == sle);
+    assert (entry->mSeq == mSeq);
+    assert (entry->mEntry == sle);
 
-    switch (it->second.mAction)
+    switch (entry->mAction)
     {
     case taaCACHED:
-        it->second.mAction  = taaMODIFY;
+        entry->mAction  = taaMODIFY;
 
         // Fall through
 
     case taaCREATE:
     case taaMODIFY:
-        it->second.mSeq     = mSeq;
-        it->second.mEntry   = sle;
+        entry->mSeq     = mSeq;
+        entry->mEntry   = sle;
         break;
 
     case taaDELETE:
@@ -240,31 +482,31 @@ void LedgerEntrySet::entryDelete (SLE::ref sle)
 {
     assert (sle->isMutable () && !mImmutable);
     assert (mLedger);
-    auto it = mEntries.find (sle->getIndex ());
+    auto const entry = find (sle->getIndex ());
 
-    if (it == mEntries.end ())
+    if (entry == nullptr)
     {
         assert (false); // deleting an entry not cached?
 
-        mEntries.insert (std::make_pair (sle->getIndex (), LedgerEntrySetEntry (sle, taaDELETE, mSeq)));
+        insert (sle->getIndex (), LedgerEntrySetEntry (sle, taaDELETE, mSeq));
 
         return;
     }
 
-    assert (it->second.mSeq == mSeq);
-    assert (it->second.mEntry == sle);
+    assert (entry->mSeq == mSeq);
+    assert (entry->mEntry == sle);
 
-    switch (it->second.mAction)
+    switch (entry->mAction)
     {
     case taaCACHED:
     case taaMODIFY:
-        it->second.mSeq     = mSeq;
-        it->second.mEntry   = sle;
-        it->second.mAction  = taaDELETE;
+        entry->mSeq     = mSeq;
+        entry->mEntry   = sle;
+        entry->mAction  = taaDELETE;
         break;
 
     case taaCREATE:
-        mEntries.erase (it);
+        erase (sle->getIndex ());
         break;
 
     case taaDELETE:
@@ -281,8 +523,13 @@ Json::Value LedgerEntrySet::getJson (int) const
 
     Json::Value nodes (Json::arrayValue);
 
-    for (auto it = mEntries.begin (), end = mEntries.end (); it != end; ++it)
+    Merge merge (mEntries, mBase.get ());
+
+    while (auto const it = merge.next ())
     {
+        if (it->second.mAction == taaNONE)
+            continue;
+
         Json::Value entry (Json::objectValue);
         entry[jss::node] = to_string (it->first);
 
@@ -351,27 +598,27 @@ Json::Value LedgerEntrySet::getJson (int) const
 SLE::pointer LedgerEntrySet::getForMod (uint256 const& node, Ledger::ref ledger,
                                         NodeToLedgerEntry& newMods)
 {
-    auto it = mEntries.find (node);
+    auto const entry = find (node);
 
-    if (it != mEntries.end ())
+    if (entry != nullptr)
     {
-        if (it->second.mAction == taaDELETE)
+        if (entry->mAction == taaDELETE)
         {
             WriteLog (lsFATAL, LedgerEntrySet) << "Trying to thread to deleted node";
 
             return SLE::pointer ();
         }
 
-        if (it->second.mAction == taaCACHED)
-            it->second.mAction = taaMODIFY;
+        if (entry->mAction == taaCACHED)
+            entry->mAction = taaMODIFY;
 
-        if (it->second.mSeq != mSeq)
+        if (entry->mSeq != mSeq)
         {
-            it->second.mEntry = std::make_shared<STLedgerEntry> (*it->second.mEntry);
-            it->second.mSeq = mSeq;
+            entry->mEntry = std::make_shared<STLedgerEntry> (*entry->mEntry);
+            entry->mSeq = mSeq;
         }
 
-        return it->second.mEntry;
+        return entry->mEntry;
     }
 
     auto me = newMods.find (node);
@@ -469,6 +716,9 @@ void LedgerEntrySet::calcRawMeta (Serializer& s, TER result, std::uint32_t index
     // Entries modified only as a result of building the transaction metadata
     NodeToLedgerEntry newMod;
 
+    // With no shared layers left, threading below can't add entries
+    flatten ();
+
     for (auto& it : mEntries)
     {
         auto type = &sfGeneric;
@@ -1014,22 +1264,25 @@ uint256 LedgerEntrySet::getNextLedgerIndex (uint256 const& uHash)
 {
     // find next node in ledger that isn't deleted by LES
     uint256 ledgerNext = uHash;
-    std::map<uint256, LedgerEntrySetEntry>::const_iterator it;
+    LedgerEntrySetEntry const* entry;
 
     do
     {
         ledgerNext = mLedger->getNextLedgerIndex (ledgerNext);
-        it  = mEntries.find (ledgerNext);
+        entry = peek (ledgerNext);
     }
-    while ((it != mEntries.end ()) && (it->second.mAction == taaDELETE));
+    while ((entry != nullptr) && (entry->mAction == taaDELETE));
 
     // find next node in LES that isn't deleted
-    for (it = mEntries.upper_bound (uHash); it != mEntries.end (); ++it)
+    Merge merge (mEntries, mBase.get (), &uHash);
+
+    while (auto const next = merge.next ())
     {
         // node found in LES, node found in ledger, return earliest
-        if (it->second.mAction != taaDELETE)
-            return (ledgerNext.isNonZero () && (ledgerNext < it->first)) ?
-                    ledgerNext : it->first;
+        if ((next->second.mAction != taaDELETE) &&
+                (next->second.mAction != taaNONE))
+            return (ledgerNext.isNonZero () && (ledgerNext < next->first)) ?
+                    ledgerNext : next->first;
     }
 
     // nothing next in LES, return next ledger node
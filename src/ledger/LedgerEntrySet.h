@@ -26,6 +26,8 @@
 #include <common/base/CountedObject.h>
 #include <protocol/STLedgerEntry.h>
 #include <common/misc/Zero.h>
+#include <memory>
+#include <vector>
 
 namespace skywell {
 
@@ -113,7 +115,10 @@ public:
     {
     }
 
-    // Make a duplicate of this set.
+    // Make a duplicate of this set. Duplicating a non-const set moves its
+    // changes into a layer both sets share. A const set is left as it is,
+    // so its changes are copied.
+    LedgerEntrySet duplicate ();
     LedgerEntrySet duplicate () const;
 
     // Swap the contents of two sets
@@ -270,36 +275,25 @@ public:
     Json::Value getJson (int) const;
     void calcRawMeta (Serializer&, TER result, std::uint32_t index);
 
+    // Entries are kept sorted by index
+    typedef std::pair<uint256, LedgerEntrySetEntry> value_type;
+    typedef std::vector<value_type> Entries;
+
     // iterator functions
-    typedef std::map<uint256, LedgerEntrySetEntry>::iterator iterator;
-    typedef std::map<uint256, LedgerEntrySetEntry>::const_iterator const_iterator;
+    // Iterating collapses any shared layers into this set first, so only
+    // a non-const set can be iterated.
+    typedef Entries::iterator iterator;
+
+    bool empty () const;
 
-    bool empty () const
-    {
-        return mEntries.empty ();
-    }
-    const_iterator cbegin () const
-    {
-        return mEntries.cbegin ();
-    }
-    const_iterator cend () const
-    {
-        return mEntries.cend ();
-    }
-    const_iterator begin () const
-    {
-        return mEntries.cbegin ();
-    }
-    const_iterator end () const
-    {
-        return mEntries.cend ();
-    }
     iterator begin ()
     {
+        flatten ();
         return mEntries.begin ();
     }
     iterator end ()
     {
+        flatten ();
         return mEntries.end ();
     }
 
@@ -322,8 +316,24 @@ public:
 
     Account AuthorizeAccountGet (Account const& account, Currency const& currency);
 private:
+    // An immutable run of entries shared between a set and its duplicates.
+    // Entries in a layer hide those with the same index in its parents.
+    struct Layer
+    {
+        std::shared_ptr<Layer const> parent;
+        Entries entries;
+        int depth;
+    };
+
+    class Merge;
+
     Ledger::pointer mLedger;
-    std::map<uint256, LedgerEntrySetEntry>  mEntries; // cannot be unordered!
+
+    // Changes made since the last duplicate, over the shared layers.
+    // Ordering matters, so these cannot be unordered!
+    Entries mEntries;
+    std::shared_ptr<Layer const> mBase;
+
     // Defers credits made to accounts until later
     boost::optional<DeferredCredits> mDeferredCredits;
 
@@ -335,12 +345,34 @@ private:
     bool mImmutable;
 
     LedgerEntrySet (
-        Ledger::ref ledger, const std::map<uint256, LedgerEntrySetEntry>& e,
+        Ledger::ref ledger, std::shared_ptr<Layer const> const& base,
         const TransactionMetaSet & s, int m, boost::optional<DeferredCredits> const& ft) :
-        mLedger (ledger), mEntries (e), mDeferredCredits (ft), mSet (s), mParams (tapNONE),
+        mLedger (ledger), mBase (base), mDeferredCredits (ft), mSet (s), mParams (tapNONE),
         mSeq (m), mImmutable (false)
     {}
 
+    // Returns the entry for an index, copying it out of a shared layer
+    // so that it can be changed. Returns null if there is none.
+    LedgerEntrySetEntry* find (uint256 const& index);
+
+    // Returns the entry for an index without copying it.
+    LedgerEntrySetEntry const* peek (uint256 const& index) const;
+
+    // Adds an entry that find did not return.
+    void insert (uint256 const& index, LedgerEntrySetEntry const& entry);
+
+    void erase (uint256 const& index);
+
+    // Returns a shared layer holding entries over parent.
+    static std::shared_ptr<Layer const> makeLayer (
+        Entries entries, std::shared_ptr<Layer const> const& parent);
+
+    // Moves the changes into a new shared layer.
+    void freeze ();
+
+    // Collapses the shared layers into mEntries.
+    void flatten ();
+
     SLE::pointer getForMod (
         uint256 const& node, Ledger::ref ledger,
         NodeToLedgerEntry& newMods);
@@ -49,6 +49,9 @@ namespace skywell {
 #define MIN_VALIDATION_RATIO    150     // 150/256ths of validations of previous ledger
 #define MAX_LEDGER_GAP          100     // Don't catch up more than 100 ledgers  (cannot exceed 256)
 #define MAX_LEDGER_AGE_ACQUIRE  60      // Don't acquire history if ledger is too old
+#define CATCHUP_LEDGER_GAP      256     // Use catch-up packs when missing this many ledgers
+#define CATCHUP_PACK_LEDGERS    32      // Ledgers we expect a catch-up pack to cover
+#define CATCHUP_PACK_PEERS      4       // Peers to request catch-up packs from at once
 
 class LedgerMasterImp : public LedgerMaster
 {
@@ -74,6 +77,8 @@ public:
 
     CanonicalTXSet mHeldTransactions;
 
+    std::unique_ptr <TxQ> mTxQ;
+
     LockType mCompleteLock;
     RangeSet mCompleteLedgers;
 
@@ -116,6 +121,7 @@ public:
         , m_journal (journal)
         , mLedgerHistory (collector)
         , mHeldTransactions (uint256 ())
+        , mTxQ (TxQ::New (collector, deprecatedLogs().journal("TxQ")))
         , mLedgerCleaner (make_LedgerCleaner (*this, deprecatedLogs().journal("LedgerCleaner")))
         , mMinValidations (0)
         , mLastValidateSeq (0)
@@ -256,6 +262,11 @@ public:
         mPubLedgerSeq = l->getLedgerSeq();
     }
 
+    TxQ& getTxQ ()
+    {
+        return *mTxQ;
+    }
+
     void addHeldTransaction (Transaction::ref transaction)
     {
         // returns true if transaction was added
@@ -394,6 +405,9 @@ public:
 
         CondLog (recovers != 0, lsINFO, LedgerMaster) << "Recovered " << recovers << " held transactions";
 
+        // Then whatever the queue can now fit in
+        mTxQ->apply (engine);
+
         //  TODO recreate the CanonicalTxSet object instead of resetting it
         mHeldTransactions.reset (engine.getLedger()->getHash ());
         mCurrentLedger.set (engine.getLedger ());
@@ -610,6 +624,21 @@ public:
     */
     void getFetchPack (LedgerHash missingHash, LedgerIndex missingIndex)
     {
+        std::uint32_t have;
+        {
+            ScopedLockType sl (mCompleteLock);
+            have = mCompleteLedgers.getPrev (missingIndex);
+        }
+
+        std::uint32_t const gap = (have == RangeSet::absent) ?
+            missingIndex : (missingIndex - have);
+
+        if (gap >= CATCHUP_LEDGER_GAP)
+        {
+            getCatchUpPacks (missingIndex, gap);
+            return;
+        }
+
         uint256 haveHash = getLedgerHashForHistory (missingIndex + 1);
 
         if (haveHash.isZero())
@@ -650,6 +679,68 @@ public:
         }
     }
 
+    /** Request catch-up packs for a large run of missing ledgers
+
+        Each peer is asked for a large pack covering a different range
+        of ledgers below the specified ledger, so the whole gap is filled
+        in parallel with every ledger's nodes written to the node store
+        in bulk.
+    */
+    void getCatchUpPacks (LedgerIndex missingIndex, std::uint32_t gap)
+    {
+        Overlay::PeerSequence peerList = getApp().overlay ().getActivePeers ();
+        std::random_shuffle (peerList.begin (), peerList.end ());
+
+        auto peer = peerList.begin ();
+        int requested = 0;
+
+        for (std::uint32_t offset = 0;
+            (offset < gap) && (requested < CATCHUP_PACK_PEERS) &&
+                (peer != peerList.end ());
+            offset += CATCHUP_PACK_LEDGERS)
+        {
+            LedgerIndex const index = missingIndex - offset;
+
+            if (index <= 1)
+                break;
+
+            uint256 haveHash = getLedgerHashForHistory (index + 1);
+
+            if (haveHash.isZero ())
+                break;
+
+            // Find the next peer that has this range
+            while ((peer != peerList.end ()) && !(*peer)->hasRange (index, index + 1))
+                ++peer;
+
+            if (peer == peerList.end ())
+                break;
+
+            protocol::TMGetObjectByHash tmBH;
+            tmBH.set_query (true);
+            tmBH.set_type (protocol::TMGetObjectByHash::otFETCH_PACK);
+            tmBH.set_fat (true);
+            tmBH.set_ledgerhash (haveHash.begin(), 32);
+
+            getApp().getOPs ().expectCatchUpPack (haveHash, (*peer)->id ());
+            (*peer)->send (std::make_shared<Message> (tmBH, protocol::mtGET_OBJECTS));
+            ++peer;
+            ++requested;
+
+            WriteLog (lsTRACE, LedgerMaster) << "Requested catch-up pack for " << index;
+        }
+
+        if (requested == 0)
+        {
+            WriteLog (lsDEBUG, LedgerMaster) << "No peer for catch-up pack";
+        }
+        else
+        {
+            WriteLog (lsDEBUG, LedgerMaster) << "Requested " << requested
+                << " catch-up packs for " << gap << " missing ledgers";
+        }
+    }
+
     void fixMismatch (Ledger::ref ledger)
     {
         int invalidate = 0;
@@ -21,6 +21,7 @@
 #define SKYWELL_APP_LEDGER_LEDGERMASTER_H_INCLUDED
 
 #include <ledger/LedgerEntrySet.h>
+#include <transaction/tx/TxQ.h>
 #include <common/base/StringUtilities.h>
 #include <common/core/Config.h>
 #include <protocol/SkywellLedgerHash.h>
@@ -116,6 +117,9 @@ public:
     virtual uint256 getLedgerHash(std::uint32_t desiredSeq, Ledger::ref knownGoodLedger) = 0;
 
     virtual void addHeldTransaction (Transaction::ref trans) = 0;
+
+    // Transactions waiting for a later open ledger
+    virtual TxQ& getTxQ () = 0;
     virtual void fixMismatch (Ledger::ref ledger) = 0;
 
     virtual bool haveLedgerRange (std::uint32_t from, std::uint32_t to) = 0;
@@ -103,6 +103,7 @@ bool ContinuousLedgerTiming::haveConsensus (
     int currentFinished,        // proposers who have validated a ledger after this one
     int previousAgreeTime,      // how long it took to agree on the last ledger
     int currentAgreeTime,       // how long we've been trying to agree
+    int minConsensusTime,       // how long to wait for initial positions
     bool forReal,               // deciding whether to stop consensus process
     bool& failed)               // we can't reach a consensus
 {
@@ -113,7 +114,7 @@ bool ContinuousLedgerTiming::haveConsensus (
         " time=" << currentAgreeTime <<  "/" << previousAgreeTime <<
         (forReal ? "" : "X");
 
-    if (currentAgreeTime <= LEDGER_MIN_CONSENSUS)
+    if (currentAgreeTime <= minConsensusTime)
         return false;
 
     if (currentProposers < (previousProposers * 3 / 4))
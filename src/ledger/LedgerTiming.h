@@ -101,6 +101,7 @@ public:
         int previousProposers,      int currentProposers,
         int currentAgree,           int currentClosed,
         int previousAgreeTime,      int currentAgreeTime,
+        int minConsensusTime,
         bool forReal,               bool& failed);
 
     static int getNextLedgerTimeResolution (int previousResolution, bool previousAgree, int ledgerSeq);
@@ -24,13 +24,22 @@
 #include <common/base/Log.h>
 #include <common/core/Config.h>
 #include <common/core/JobQueue.h>
+#include <ledger/LedgerEntrySet.h>
 #include <protocol/Indexes.h>
+#include <protocol/JsonFields.h>
+#include <algorithm>
 
 namespace skywell {
 
+// Published ledgers between full scans that check the incremental updates
+static std::uint32_t const consistencyScanInterval = 2048;
+
 OrderBookDB::OrderBookDB (Stoppable& parent)
     : Stoppable ("OrderBookDB", parent)
     , mSeq (0)
+    , mScanSeq (0)
+    , mUpdating (false)
+    , mDeltaSeq (0)
 {
 }
 
@@ -43,29 +52,57 @@ void OrderBookDB::invalidate ()
 
 void OrderBookDB::setup (Ledger::ref ledger)
 {
+    Ledger::pointer rescan;
+
     {
         ScopedLockType sl (mLock);
-        auto seq = ledger->getLedgerSeq ();
+        rescan = advance (ledger);
+    }
 
-        // Do a full update every 256 ledgers
-        if (mSeq != 0)
-        {
-            if (seq == mSeq)
-                return;
+    if (rescan)
+        scan (rescan);
+}
 
-            if ((seq > mSeq) && ((seq - mSeq) < 256))
-                return;
+Ledger::pointer OrderBookDB::advance (Ledger::ref ledger)
+{
+    auto const seq = ledger->getLedgerSeq ();
 
-            if ((seq < mSeq) && ((mSeq - seq) < 16))
-                return;
-        }
+    if (seq == mSeq)
+        return Ledger::pointer ();
+
+    // Published ledgers that follow one another keep the books current
+    bool const follows = (mSeq != 0) && (ledger->getParentHash () == mHash);
 
-        WriteLog (lsDEBUG, OrderBookDB) << "Advancing from " 
-                                        << mSeq << " to " << seq;
+    WriteLog (follows ? lsTRACE : lsDEBUG, OrderBookDB) << "Advancing from "
+                                    << mSeq << " to " << seq;
 
-        mSeq = seq;
+    mSeq = seq;
+    mHash = ledger->getHash ();
+
+    if (follows)
+    {
+        // Now and then a full scan checks what the metadata told us
+        if (mUpdating || (seq < (mScanSeq + consistencyScanInterval)))
+            return Ledger::pointer ();
+
+        WriteLog (lsDEBUG, OrderBookDB) << "Checking books at " << seq;
     }
+    else if (mUpdating)
+    {
+        // Scan again once the running scan is done
+        mRescan = ledger;
+        return Ledger::pointer ();
+    }
+
+    mUpdating = true;
+    mScanSeq = seq;
+    mChanges.clear ();
 
+    return ledger;
+}
+
+void OrderBookDB::scan (Ledger::ref ledger)
+{
     if (getConfig().RUN_STANDALONE)
     {
         update(ledger);
@@ -139,27 +176,113 @@ void OrderBookDB::update (Ledger::pointer ledger)
         ScopedLockType sl (mLock);
 
         mSeq = 0;
+        mUpdating = false;
+        mChanges.clear ();
+        mRescan.reset ();
 
         return;
     }
 
     WriteLog (lsDEBUG, OrderBookDB) << "OrderBookDB::update< " << books << " books found";
+
+    Ledger::pointer rescan;
+
     {
         ScopedLockType sl (mLock);
 
+        // The books we already had should match the scan, apart from
+        // books added speculatively from open ledgers and books created
+        // since the scanned ledger
+        int missing = 0;
+        int extra = 0;
+
+        for (auto const& it : sourceMap)
+        {
+            auto const current = mSourceMap.find (it.first);
+
+            for (auto const& book : it.second)
+            {
+                if ((current == mSourceMap.end ()) ||
+                    std::none_of (current->second.begin (), current->second.end (),
+                        [&book] (OrderBook::pointer const& ob)
+                        {
+                            return ob->getBookBase () == book->getBookBase ();
+                        }))
+                {
+                    ++missing;
+                }
+            }
+        }
+
+        for (auto const& it : mSourceMap)
+        {
+            auto const scanned = sourceMap.find (it.first);
+
+            for (auto const& book : it.second)
+            {
+                if ((scanned == sourceMap.end ()) ||
+                    std::none_of (scanned->second.begin (), scanned->second.end (),
+                        [&book] (OrderBook::pointer const& ob)
+                        {
+                            return ob->getBookBase () == book->getBookBase ();
+                        }))
+                {
+                    ++extra;
+                }
+            }
+        }
+
+        CondLog (!mSourceMap.empty () && (missing != 0), lsWARNING, OrderBookDB)
+            << "OrderBookDB::update found " << missing << " untracked books";
+
+        CondLog (!mSourceMap.empty (), lsINFO, OrderBookDB)
+            << "OrderBookDB::update checked " << books << " books at "
+            << ledger->getLedgerSeq () << ": " << missing << " missing, "
+            << extra << " extra";
+
         mSWTBooks.swap(SWTBooks);
         mSourceMap.swap(sourceMap);
         mDestMap.swap(destMap);
+
+        // Replay what changed in the ledgers published since
+        for (auto const& change : mChanges)
+        {
+            if (change.seq <= ledger->getLedgerSeq ())
+                continue;
+
+            if (change.added)
+                rawAddBook (change.book);
+            else
+                rawRemoveBook (change.book);
+        }
+
+        mUpdating = false;
+        mChanges.clear ();
+
+        if (mRescan)
+        {
+            rescan.swap (mRescan);
+            mUpdating = true;
+        }
     }
 
     getApp ().getLedgerMaster ().newOrderBookDB ();
+
+    if (rescan)
+        scan (rescan);
 }
 
 void OrderBookDB::addOrderBook(Book const& book)
 {
-    bool toSWT = isSWT (book.out);
     ScopedLockType sl (mLock);
 
+    rawAddBook (book);
+}
+
+void OrderBookDB::rawAddBook(Book const& book)
+{
+    bool toSWT = isSWT (book.out);
+
     if (toSWT)
     {
         // We don't want to search through all the to-SWT or from-SWT order
@@ -190,6 +313,100 @@ void OrderBookDB::addOrderBook(Book const& book)
         mSWTBooks.insert(book.in);
 }
 
+void OrderBookDB::rawRemoveBook(Book const& book)
+{
+    uint256 const index = getBookBase (book);
+
+    auto const matches = [&index] (OrderBook::pointer const& ob)
+    {
+        return ob->getBookBase () == index;
+    };
+
+    auto remove = [&matches] (IssueToOrderBook& map, Issue const& issue)
+    {
+        auto it = map.find (issue);
+
+        if (it == map.end ())
+            return;
+
+        auto& books = it->second;
+        books.erase (std::remove_if (books.begin (), books.end (), matches),
+            books.end ());
+
+        if (books.empty ())
+            map.erase (it);
+    };
+
+    remove (mSourceMap, book.in);
+    remove (mDestMap, book.out);
+
+    if (isSWT (book.out))
+    {
+        auto it = mSourceMap.find (book.in);
+
+        if ((it == mSourceMap.end ()) ||
+            std::none_of (it->second.begin (), it->second.end (),
+                [] (OrderBook::pointer const& ob)
+                {
+                    return isSWT (ob->book ().out);
+                }))
+        {
+            mSWTBooks.erase (book.in);
+        }
+    }
+}
+
+void OrderBookDB::updateBook (Ledger::ref ledger, STObject const& node)
+{
+    bool added;
+    SField const* field;
+
+    if (node.getFName () == sfCreatedNode)
+    {
+        added = true;
+        field = &sfNewFields;
+    }
+    else if (node.getFName () == sfDeletedNode)
+    {
+        added = false;
+        field = &sfFinalFields;
+    }
+    else
+    {
+        return;
+    }
+
+    auto data = dynamic_cast<const STObject*> (node.peekAtPField (*field));
+
+    // Only the root of a quality directory describes its book
+    if (!data || !data->isFieldPresent (sfExchangeRate) ||
+        (data->getFieldH256 (sfRootIndex) != node.getFieldH256 (sfLedgerIndex)))
+        return;
+
+    Book book;
+    book.in.currency.copyFrom  (data->getFieldH160 (sfTakerPaysCurrency));
+    book.in.account.copyFrom   (data->getFieldH160 (sfTakerPaysIssuer));
+    book.out.account.copyFrom  (data->getFieldH160 (sfTakerGetsIssuer));
+    book.out.currency.copyFrom (data->getFieldH160 (sfTakerGetsCurrency));
+
+    if (!added)
+    {
+        // The book lives on while it has any other quality directory
+        uint256 const base = getBookBase (book);
+
+        if (ledger->getNextLedgerIndex (base, getQualityNext (base)).isNonZero ())
+            return;
+    }
+
+    if (mUpdating)
+        mChanges.push_back ({ledger->getLedgerSeq (), book, added});
+
+    if (added)
+        rawAddBook (book);
+    else
+        rawRemoveBook (book);
+}
+
 // return list of all orderbooks that want this issuerID and currencyID
 OrderBook::List OrderBookDB::getBooksByTakerPays (Issue const& issue)
 {
@@ -250,6 +467,18 @@ void OrderBookDB::processTxn (Ledger::ref ledger,
                               const AcceptedLedgerTx& alTx, 
                               Json::Value const& jvObj)
 {
+    {
+        Ledger::pointer rescan;
+
+        {
+            ScopedLockType sl (mLock);
+            rescan = advance (ledger);
+        }
+
+        if (rescan)
+            scan (rescan);
+    }
+
     ScopedLockType sl (mLock);
 
     if (alTx.getResult () == tesSUCCESS)
@@ -261,7 +490,11 @@ void OrderBookDB::processTxn (Ledger::ref ledger,
         {
             try
             {
-                if (node.getFieldU16 (sfLedgerEntryType) == ltOFFER)
+                if (node.getFieldU16 (sfLedgerEntryType) == ltDIR_NODE)
+                {
+                    updateBook (ledger, node);
+                }
+                else if (node.getFieldU16 (sfLedgerEntryType) == ltOFFER)
                 {
                     SField const* field = nullptr;
 
@@ -286,7 +519,12 @@ void OrderBookDB::processTxn (Ledger::ref ledger,
                                  data->getFieldAmount (sfTakerPays).issue()});
 
                             if (listeners)
+                            {
                                 listeners->publish (jvObj);
+
+                                if (listeners->wantsDeltas ())
+                                    addBookDelta (ledger, node);
+                            }
                         }
                     }
                 }
@@ -299,4 +537,146 @@ void OrderBookDB::processTxn (Ledger::ref ledger,
     }
 }
 
+void OrderBookDB::addBookDelta (Ledger::ref ledger, STObject const& node)
+{
+    OfferStatus status;
+    SField const* field;
+
+    if (node.getFName () == sfCreatedNode)
+    {
+        status = osCREATED;
+        field = &sfNewFields;
+    }
+    else if (node.getFName () == sfModifiedNode)
+    {
+        status = osMODIFIED;
+        field = &sfFinalFields;
+    }
+    else if (node.getFName () == sfDeletedNode)
+    {
+        status = osDELETED;
+        field = &sfFinalFields;
+    }
+    else
+        return;
+
+    auto data = dynamic_cast<const STObject*> (node.peekAtPField (*field));
+
+    if (!data)
+        return;
+
+    if (mDeltaSeq != ledger->getLedgerSeq ())
+    {
+        // Anything left over was never published
+        mDeltas.clear ();
+        mDeltaSeq = ledger->getLedgerSeq ();
+    }
+
+    OfferDelta delta {
+        status,
+        data->getFieldAccount160 (sfAccount),
+        data->getFieldAmount (sfTakerGets),
+        data->getFieldAmount (sfTakerPays)};
+
+    // Keyed the same way processTxn finds the book's listeners
+    auto& offers = mDeltas[{delta.takerGets.issue (), delta.takerPays.issue ()}];
+    auto const index = node.getFieldH256 (sfLedgerIndex);
+    auto it = offers.find (index);
+
+    if (it == offers.end ())
+    {
+        offers.emplace (index, delta);
+    }
+    else if (it->second.status == osCREATED)
+    {
+        // Listeners never saw this offer, so it stays new or never existed
+        if (status == osDELETED)
+            offers.erase (it);
+        else
+            it->second = {osCREATED, delta.owner, delta.takerGets,
+                delta.takerPays};
+    }
+    else
+    {
+        it->second = delta;
+    }
+}
+
+void OrderBookDB::pubBookDeltas (Ledger::ref ledger)
+{
+    BookToDeltasMap deltas;
+    Ledger::pointer rescan;
+
+    {
+        ScopedLockType sl (mLock);
+
+        // Ledgers without transactions still extend the chain
+        rescan = advance (ledger);
+
+        if (mDeltaSeq == ledger->getLedgerSeq ())
+            deltas.swap (mDeltas);
+    }
+
+    if (rescan)
+        scan (rescan);
+
+    if (deltas.empty ())
+        return;
+
+    LedgerEntrySet les (ledger, tapNONE, true);
+
+    auto issueJson = [](Issue const& issue)
+    {
+        Json::Value jv (Json::objectValue);
+        jv[jss::currency] = to_string (issue.currency);
+
+        if (!isSWT (issue.currency))
+            jv[jss::issuer] = to_string (issue.account);
+
+        return jv;
+    };
+
+    for (auto const& book : deltas)
+    {
+        auto listeners = getBookListeners (book.first);
+
+        if (!listeners || book.second.empty ())
+            continue;
+
+        Json::Value jvObj (Json::objectValue);
+
+        jvObj[jss::type] = "bookDelta";
+        jvObj[jss::ledger_index] = ledger->getLedgerSeq ();
+        jvObj[jss::ledger_hash] = to_string (ledger->getHash ());
+        jvObj[jss::taker_gets] = issueJson (book.first.in);
+        jvObj[jss::taker_pays] = issueJson (book.first.out);
+
+        Json::Value& jvOffers = (jvObj[jss::offers] = Json::arrayValue);
+
+        for (auto const& offer : book.second)
+        {
+            Json::Value& jvOffer = jvOffers.append (Json::objectValue);
+            auto const& delta = offer.second;
+
+            jvOffer[jss::index] = to_string (offer.first);
+            jvOffer[jss::Account] = to_string (delta.owner);
+
+            if (delta.status == osDELETED)
+            {
+                jvOffer[jss::status] = "deleted";
+                continue;
+            }
+
+            jvOffer[jss::status] =
+                delta.status == osCREATED ? "created" : "modified";
+            jvOffer[jss::TakerGets] = delta.takerGets.getJson (0);
+            jvOffer[jss::TakerPays] = delta.takerPays.getJson (0);
+            jvOffer[jss::owner_funds] = les.accountFunds (delta.owner,
+                delta.takerGets, fhZERO_IF_FROZEN).getText ();
+        }
+
+        listeners->publishDelta (jvObj);
+    }
+}
+
 } // skywell
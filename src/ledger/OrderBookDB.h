@@ -23,6 +23,7 @@
 #include <ledger/AcceptedLedgerTx.h>
 #include <ledger/BookListeners.h>
 #include <common/misc/OrderBook.h>
+#include <map>
 
 namespace skywell {
 
@@ -31,6 +32,13 @@ class OrderBookDB : public beast::Stoppable
 public:
     explicit OrderBookDB (Stoppable& parent);
 
+    /** Rebuild the order books from a full scan of the ledger.
+        The first ledger, and a ledger that does not follow the last one
+        published, is scanned. Otherwise the books are kept current from
+        the metadata of the transactions passed to processTxn, and a scan
+        every few thousand ledgers checks them and drops books added
+        speculatively from open ledgers.
+    */
     void setup (Ledger::ref ledger);
     void update (Ledger::pointer ledger);
     void invalidate ();
@@ -50,15 +58,44 @@ public:
     BookListeners::pointer getBookListeners (Book const&);
     BookListeners::pointer makeBookListeners (Book const&);
 
-    // see if this txn effects any orderbook
+    // see if this txn effects any orderbook, and track the books it
+    // creates or removes
     void processTxn (
         Ledger::ref ledger, const AcceptedLedgerTx& alTx,
         Json::Value const& jvObj);
 
+    /** Send delta listeners the offers that processTxn saw change in their
+        books, with each offer's state and funding at the end of the ledger.
+    */
+    void pubBookDeltas (Ledger::ref ledger);
+
     typedef hash_map<Issue, OrderBook::List> IssueToOrderBook;
 
 private:
     void rawAddBook(Book const&);
+    void rawRemoveBook(Book const&);
+
+    // Note a published ledger. Returns the ledger to scan if it does not
+    // follow the last one or a check is due, with the scan marked as
+    // running.
+    Ledger::pointer advance (Ledger::ref ledger);
+
+    // Run the full scan of the ledger, must not hold the lock
+    void scan (Ledger::ref ledger);
+
+    // Track a book created or removed by a transaction
+    void updateBook (Ledger::ref ledger, STObject const& node);
+
+    // Record an offer's change for the book's delta listeners
+    void addBookDelta (Ledger::ref ledger, STObject const& node);
+
+    // A book created or removed while a full scan was running
+    struct BookChange
+    {
+        std::uint32_t seq;
+        Book book;
+        bool added;
+    };
 
     // by ci/ii
     IssueToOrderBook mSourceMap;
@@ -78,7 +115,40 @@ private:
 
     BookToListenersMap mListeners;
 
+    // The last ledger published or scanned
     std::uint32_t mSeq;
+    uint256 mHash;
+
+    // The last ledger a full scan was started for
+    std::uint32_t mScanSeq;
+
+    // Changes to replay over the result of the running scan
+    bool mUpdating;
+    std::vector<BookChange> mChanges;
+
+    // A gap seen while a scan was running
+    Ledger::pointer mRescan;
+
+    enum OfferStatus
+    {
+        osCREATED,
+        osMODIFIED,
+        osDELETED
+    };
+
+    // The last state of an offer changed in the ledger being published
+    struct OfferDelta
+    {
+        OfferStatus status;
+        Account owner;
+        STAmount takerGets;
+        STAmount takerPays;
+    };
+
+    typedef hash_map<Book, std::map<uint256, OfferDelta>> BookToDeltasMap;
+
+    std::uint32_t mDeltaSeq;
+    BookToDeltasMap mDeltas;
 };
 
 } // skywell
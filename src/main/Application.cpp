@@ -387,6 +387,7 @@ public:
         , m_networkOPs (make_NetworkOPs (get_seconds_clock (),
             getConfig ().RUN_STANDALONE, getConfig ().NETWORK_QUORUM,
             *m_jobQueue, *m_ledgerMaster, *m_jobQueue,
+            m_collectorManager->collector (),
             m_logs.journal("NetworkOPs")))
 
         //  NOTE LocalCredentials starts the deprecated UNL service
@@ -823,7 +824,7 @@ public:
         //             if (!getConfig ().RUN_STANDALONE)
         m_overlay = make_Overlay (setup_Overlay(getConfig()), *m_jobQueue,
             *serverHandler_, *m_resourceManager, *m_resolver, get_io_service(),
-            getConfig());
+            getConfig(), m_collectorManager->group ("overlay"));
         add (*m_overlay); // add to PropertyStream
 
         {
@@ -1048,6 +1049,9 @@ public:
         logTimedCall (m_journal.warning, "NetworkOPs::sweepFetchPack", __FILE__, __LINE__, std::bind (
             &NetworkOPs::sweepFetchPack, m_networkOPs.get ()));
 
+        logTimedCall (m_journal.warning, "NetworkOPs::sweepBookPages", __FILE__, __LINE__, std::bind (
+            &NetworkOPs::sweepBookPages, m_networkOPs.get ()));
+
         //  NOTE does the call to sweep() happen on another thread?
         m_sweepTimer.setExpiration (getConfig ().getSize (siSweepInterval));
     }
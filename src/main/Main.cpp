@@ -132,6 +132,7 @@ void printHelp (const po::options_description& desc)
 		"     ledger_request <ledger>\n"
 		"     ledger_header <ledger>\n"
 		"     logrotate \n"
+		"     path_find_replay <file> [<ledger>]\n"
 		"     peers\n"
 		"     random\n"
 		"     rpc_info [print [<command>]] [reset]\n"
@@ -143,6 +144,7 @@ void printHelp (const po::options_description& desc)
 		"     server_info\n"
 		"     blacklist_info\n"
 		"     thread_info [<job_name>] [reset]\n"
+		"     traffic_info\n"
 		"     stop\n"
 		"     tx <id>\n"
 		"     unl_add <domain>|<public> [<comment>]\n"
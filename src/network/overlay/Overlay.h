@@ -110,6 +110,11 @@ public:
     Json::Value
     json () = 0;
 
+    /** Returns the traffic totals for each protocol message type. */
+    virtual
+    Json::Value
+    traffic () = 0;
+
     /** Returns a sequence representing the current list of peers.
         The snapshot is made at the time of the call.
     */
@@ -135,6 +140,13 @@ public:
     Peer::ptr
     findPeerByShortID (Peer::id_t const& id) = 0;
 
+    /** Calls the function on each active peer.
+        Unlike getActivePeers, this does not copy the list of peers.
+    */
+    virtual
+    void
+    for_each_peer (std::function<void (Peer::ptr const&)> const& f) = 0;
+
     /** Broadcast a proposal. */
     virtual
     void
@@ -176,10 +188,10 @@ public:
     >::type
     foreach(Function f)
     {
-        PeerSequence peers (getActivePeers());
-
-        for(PeerSequence::const_iterator i = peers.begin(); i != peers.end(); ++i)
-            f (*i);
+        for_each_peer ([&f](Peer::ptr const& peer)
+        {
+            f (peer);
+        });
 
         return f();
     }
@@ -200,10 +212,10 @@ public:
     >::type
     foreach(Function f)
     {
-        PeerSequence peers (getActivePeers());
-
-        for(PeerSequence::const_iterator i = peers.begin(); i != peers.end(); ++i)
-            f (*i);
+        for_each_peer ([&f](Peer::ptr const& peer)
+        {
+            f (peer);
+        });
     }
 
     /** Select from active peers
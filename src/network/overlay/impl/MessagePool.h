@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_OVERLAY_MESSAGEPOOL_H_INCLUDED
+#define SKYWELL_OVERLAY_MESSAGEPOOL_H_INCLUDED
+
+#include <network/skywell.pb.h>
+#include <network/overlay/impl/Tuning.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace skywell {
+
+/** A pool of recycled protocol message objects of one type.
+
+    Parsing into a message that was used before reuses the memory held
+    by its strings and repeated fields, so a steady flood of one message
+    type stops costing a round of allocations per message. Objects come
+    back to the pool when the last shared_ptr to them goes away, on
+    whatever thread that happens.
+*/
+template <class T>
+class MessagePool
+    : public std::enable_shared_from_this <MessagePool <T>>
+{
+public:
+    /** Returns an empty message, recycled if possible.
+        @param bytes The size of the message on the wire. Objects used
+                     for very large messages are not kept.
+    */
+    static
+    std::shared_ptr<T>
+    get (std::size_t bytes)
+    {
+        // Every outstanding message holds a reference to the pool,
+        // so it outlives this static.
+        static std::shared_ptr<MessagePool> const pool (
+            std::make_shared<MessagePool> ());
+
+        return pool->acquire (bytes);
+    }
+
+private:
+    struct Deleter
+    {
+        std::shared_ptr<MessagePool> pool;
+        bool recycle;
+
+        void
+        operator() (T* m) const
+        {
+            if (recycle)
+                pool->release (m);
+            else
+                delete m;
+        }
+    };
+
+    std::shared_ptr<T>
+    acquire (std::size_t bytes)
+    {
+        std::unique_ptr<T> m;
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+
+            if (! free_.empty ())
+            {
+                m = std::move (free_.back ());
+                free_.pop_back ();
+            }
+        }
+
+        if (! m)
+            m.reset (new T);
+
+        return std::shared_ptr<T> (m.release (), Deleter {
+            this->shared_from_this (), bytes <= Tuning::pooledMessageBytes});
+    }
+
+    void
+    release (T* m)
+    {
+        std::unique_ptr<T> p (m);
+
+        std::lock_guard<std::mutex> lock (mutex_);
+
+        if (free_.size () < Tuning::pooledMessageCount)
+            free_.push_back (std::move (p));
+    }
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> free_;
+};
+
+namespace detail {
+
+/** Selects the message types that are parsed into pooled objects. */
+template <class T>
+struct is_pooled : std::false_type { };
+
+template <> struct is_pooled <protocol::TMTransaction> : std::true_type { };
+template <> struct is_pooled <protocol::TMLedgerData> : std::true_type { };
+template <> struct is_pooled <protocol::TMProposeSet> : std::true_type { };
+template <> struct is_pooled <protocol::TMValidation> : std::true_type { };
+
+template <class T>
+typename std::enable_if<is_pooled<T>::value, std::shared_ptr<T>>::type
+makeMessage (std::size_t bytes)
+{
+    return MessagePool<T>::get (bytes);
+}
+
+template <class T>
+typename std::enable_if<! is_pooled<T>::value, std::shared_ptr<T>>::type
+makeMessage (std::size_t)
+{
+    return std::make_shared<T> ();
+}
+
+}
+
+} // skywell
+
+#endif
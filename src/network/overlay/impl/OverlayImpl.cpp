@@ -127,7 +127,8 @@ OverlayImpl::OverlayImpl (Setup const& setup
     , Resource::Manager& resourceManager
     , Resolver& resolver
     , boost::asio::io_service& io_service
-    , BasicConfig const& config)
+    , BasicConfig const& config
+    , beast::insight::Collector::ptr const& collector)
 
     : Overlay (parent)
     , io_service_ (io_service)
@@ -141,6 +142,12 @@ OverlayImpl::OverlayImpl (Setup const& setup
                                         , io_service
                                         , get_seconds_clock ()
                                         , deprecatedLogs ().journal ("PeerFinder"), config))
+    , active_ (std::make_shared<ActivePeers> ())
+    , traffic_ (collector)
+    , proposals_ (std::make_shared<SignatureBatch> (
+        jtPROPOSAL_t, "recvPropose->checkBatch"))
+    , validations_ (std::make_shared<SignatureBatch> (
+        jtVALIDATION_t, "recvValidation->checkBatch"))
     , m_resolver (resolver)
     , next_id_ (1)
     , timer_count_ (0)
@@ -415,6 +422,8 @@ OverlayImpl::add_active (std::shared_ptr<PeerImp> const& peer)
 
     list_.emplace(peer.get(), peer);
 
+    updateActivePeers ();
+
     journal_.debug <<
         "activated " << peer->getRemoteAddress() <<
         " (" << peer->id() <<
@@ -591,6 +600,8 @@ OverlayImpl::activate (std::shared_ptr<PeerImp> const& peer)
         (void) result.second;
     }
 
+    updateActivePeers ();
+
     journal_.debug << "activated " 
                    << peer->getRemoteAddress().address().to_string() + std::to_string(peer->getRemoteAddress().port()) 
                    << " (" << peer->id() 
@@ -608,6 +619,23 @@ OverlayImpl::onPeerDeactivate (Peer::id_t id, SkywellAddress const& publicKey)
 
     m_shortIdMap.erase(id);
     m_publicKeyMap.erase(publicKey);
+
+    updateActivePeers ();
+}
+
+void
+OverlayImpl::updateActivePeers ()
+{
+    auto active = std::make_shared<ActivePeers> ();
+
+    active->peers.reserve (m_publicKeyMap.size ());
+    for (auto const& e : m_publicKeyMap)
+        active->peers.push_back (e.second);
+
+    active->ids = m_shortIdMap;
+
+    std::atomic_store (&active_,
+        std::shared_ptr<ActivePeers const> (std::move (active)));
 }
 
 std::size_t
@@ -617,16 +645,13 @@ OverlayImpl::selectPeers (PeerSet& set
 {
     using item = std::pair<int, std::shared_ptr<PeerImp>>;
     std::vector<item> v;
-    {
-        std::lock_guard <decltype(mutex_)> lock (mutex_);
 
-        v.reserve(m_publicKeyMap.size());
+    v.reserve(activePeers ()->peers.size());
 
-        for_each_unlocked ([&](std::shared_ptr<PeerImp> && e)
-        {
-            v.emplace_back(e->getScore (score (e)), std::move (e));
-        });
-    }
+    for_each ([&](std::shared_ptr<PeerImp> && e)
+    {
+        v.emplace_back(e->getScore (score (e)), std::move (e));
+    });
 
     std::sort(v.begin(), v.end(),
     [](item const& lhs, item const&rhs)
@@ -649,9 +674,7 @@ OverlayImpl::selectPeers (PeerSet& set
 std::size_t
 OverlayImpl::size()
 {
-    std::lock_guard <decltype(mutex_)> lock (mutex_);
-
-    return m_publicKeyMap.size ();
+    return activePeers ()->peers.size ();
 }
 
 Json::Value
@@ -660,11 +683,9 @@ OverlayImpl::crawl()
     Json::Value jv;
     auto& av = jv["active"] = Json::Value(Json::arrayValue);
 
-    std::lock_guard<decltype(mutex_)> lock (mutex_);
-
-    for (auto const& e : m_publicKeyMap)
+    for (auto const& e : activePeers ()->peers)
     {
-        if (auto const sp = e.second.lock ())
+        if (auto const sp = e.lock ())
         {
             auto& pv = av.append(Json::Value(Json::objectValue));
             pv[jss::type] = "peer";
@@ -701,6 +722,12 @@ OverlayImpl::json ()
     return foreach (get_peer_json());
 }
 
+Json::Value
+OverlayImpl::traffic ()
+{
+    return traffic_.json ();
+}
+
 bool
 OverlayImpl::processRequest (beast::http::message const& req,
                              Handoff& handoff)
@@ -725,13 +752,13 @@ OverlayImpl::getActivePeers()
 {
     Overlay::PeerSequence ret;
 
-    std::lock_guard<decltype(mutex_)> lock (mutex_);
+    auto const active = activePeers ();
 
-    ret.reserve (m_publicKeyMap.size ());
+    ret.reserve (active->peers.size ());
 
-    for (auto const& e : m_publicKeyMap)
+    for (auto const& e : active->peers)
     {
-        auto const sp = e.second.lock ();
+        auto const sp = e.lock ();
         if (sp)
             ret.push_back (sp);
     }
@@ -740,36 +767,39 @@ OverlayImpl::getActivePeers()
 }
 
 void
-OverlayImpl::checkSanity (std::uint32_t index)
+OverlayImpl::for_each_peer (std::function<void (Peer::ptr const&)> const& f)
 {
-    std::lock_guard<decltype(mutex_)> lock (mutex_);
+    for_each ([&f](std::shared_ptr<PeerImp>&& sp)
+    {
+        f (sp);
+    });
+}
 
-    for (auto const& e : m_publicKeyMap)
+void
+OverlayImpl::checkSanity (std::uint32_t index)
+{
+    for_each ([index](std::shared_ptr<PeerImp>&& sp)
     {
-        if (auto const sp = e.second.lock ())
-            sp->checkSanity (index);
-    }
+        sp->checkSanity (index);
+    });
 }
 
 void
 OverlayImpl::check ()
 {
-    std::lock_guard<decltype(mutex_)> lock (mutex_);
-
-    for (auto const& e : m_publicKeyMap)
+    for_each ([](std::shared_ptr<PeerImp>&& sp)
     {
-        if (auto const sp = e.second.lock ())
-            sp->check ();
-    }
+        sp->check ();
+    });
 }
 
 Peer::ptr
 OverlayImpl::findPeerByShortID (Peer::id_t const& id)
 {
-    std::lock_guard <decltype(mutex_)> lock (mutex_);
+    auto const active = activePeers ();
 
-    auto const iter = m_shortIdMap.find (id);
-    if (iter != m_shortIdMap.end ())
+    auto const iter = active->ids.find (id);
+    if (iter != active->ids.end ())
         return iter->second.lock();
 
     return Peer::ptr();
@@ -966,7 +996,8 @@ make_Overlay (Overlay::Setup const& setup
             , Resource::Manager& resourceManager
             , Resolver& resolver
             , boost::asio::io_service& io_service
-            , BasicConfig const& config)
+            , BasicConfig const& config
+            , beast::insight::Collector::ptr const& collector)
 {
     return std::make_unique <OverlayImpl> (setup
                                         , parent
@@ -974,7 +1005,8 @@ make_Overlay (Overlay::Setup const& setup
                                         , resourceManager
                                         , resolver
                                         , io_service
-                                        , config);
+                                        , config
+                                        , collector);
 }
 
 }
@@ -21,6 +21,8 @@
 #define SKYWELL_OVERLAY_OVERLAYIMPL_H_INCLUDED
 
 #include <network/overlay/Overlay.h>
+#include <network/overlay/impl/SignatureBatch.h>
+#include <network/overlay/impl/TrafficCount.h>
 #include <network/peerfinder/Manager.h>
 #include <services/server/Handoff.h>
 #include <services/server/ServerHandler.h>
@@ -37,6 +39,7 @@
 #include <cassert>
 #include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <boost/asio.hpp>
@@ -120,6 +123,23 @@ private:
 
     hash_map<Peer::id_t, std::weak_ptr<PeerImp>> m_shortIdMap;
 
+    // An immutable copy of the active peers. It is rebuilt and swapped in
+    // whenever a peer is activated or deactivated, so that broadcasts and
+    // lookups read it without taking mutex_.
+    struct ActivePeers
+    {
+        std::vector<std::weak_ptr<PeerImp>> peers;
+        hash_map<Peer::id_t, std::weak_ptr<PeerImp>> ids;
+    };
+
+    std::shared_ptr<ActivePeers const> active_;
+
+    TrafficCount traffic_;
+
+    // Signature checks for trusted proposals and validations
+    std::shared_ptr<SignatureBatch> proposals_;
+    std::shared_ptr<SignatureBatch> validations_;
+
     Resolver& m_resolver;
 
     std::atomic <Peer::id_t> next_id_;
@@ -135,7 +155,8 @@ public:
                , Resource::Manager& resourceManager
                , Resolver& resolver
                , boost::asio::io_service& io_service
-               , BasicConfig const& config);
+               , BasicConfig const& config
+               , beast::insight::Collector::ptr const& collector);
 
     ~OverlayImpl();
 
@@ -166,6 +187,24 @@ public:
         return setup_;
     }
 
+    TrafficCount&
+    trafficCount()
+    {
+        return traffic_;
+    }
+
+    SignatureBatch&
+    proposalBatch()
+    {
+        return *proposals_;
+    }
+
+    SignatureBatch&
+    validationBatch()
+    {
+        return *validations_;
+    }
+
     Handoff
     onHandoff (std::unique_ptr <sslbundle>&& bundle
              , beast::http::message&& request
@@ -183,6 +222,9 @@ public:
     Peer::ptr
     findPeerByShortID (Peer::id_t const& id) override;
 
+    void
+    for_each_peer (std::function<void (Peer::ptr const&)> const& f) override;
+
     void
     send (protocol::TMProposeSet& m) override;
 
@@ -218,29 +260,30 @@ public:
     void
     onPeerDeactivate (Peer::id_t id, SkywellAddress const& publicKey);
 
+    /** Returns the current snapshot of the active peers. */
+    std::shared_ptr<ActivePeers const>
+    activePeers () const
+    {
+        return std::atomic_load (&active_);
+    }
+
     // UnaryFunc will be called as
     //  void(std::shared_ptr<PeerImp>&&)
     //
     template <class UnaryFunc>
     void
-    for_each_unlocked (UnaryFunc&& f)
+    for_each (UnaryFunc&& f)
     {
-        for (auto const& e : m_publicKeyMap)
+        auto const active = activePeers ();
+
+        for (auto const& e : active->peers)
         {
-            auto sp = e.second.lock ();
+            auto sp = e.lock ();
             if (sp)
                 f(std::move(sp));
         }
     }
 
-    template <class UnaryFunc>
-    void
-    for_each (UnaryFunc&& f)
-    {
-        std::lock_guard<decltype (mutex_)> lock (mutex_);
-        for_each_unlocked (f);
-    }
-
     std::size_t
     selectPeers (PeerSet& set
               , std::size_t limit
@@ -255,6 +298,12 @@ public:
     makePrefix (std::uint32_t id);
 
 private:
+    /** Publish a new snapshot of the active peers.
+        Call with mutex_ held.
+    */
+    void
+    updateActivePeers ();
+
     std::shared_ptr<HTTP::Writer>
     makeRedirectResponse (PeerFinder::Slot::ptr const& slot
                         , beast::http::message const& request
@@ -272,6 +321,9 @@ private:
     Json::Value
     json() override;
 
+    Json::Value
+    traffic() override;
+
     bool
     processRequest (beast::http::message const& req
                 , Handoff& handoff);
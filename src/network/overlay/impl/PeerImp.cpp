@@ -34,6 +34,8 @@
 #include <common/core/JobQueue.h>
 #include <common/json/json_reader.h>
 #include <transaction/tx/InboundTransactions.h>
+#include <transaction/tx/TransactionMaster.h>
+#include <protocol/HashPrefix.h>
 #include <protocol/BuildInfo.h>
 #include <protocol/JsonFields.h>
 #include <common/misc/SemanticVersion.h>
@@ -197,12 +199,15 @@ PeerImp::send (Message::pointer const& m)
         return;
 
     send_queue_.push(m);
+    send_times_.push(clock_type::now());
 
     if(send_queue_.size() > 1)
         return;
 
     recent_empty_ = true;
 
+    onWriteStart();
+
     boost::asio::async_write (stream_, 
                             boost::asio::buffer(send_queue_.front()->getBuffer()), 
                             strand_.wrap(std::bind(&PeerImp::onWriteMessage, 
@@ -267,6 +272,11 @@ PeerImp::json()
 
     ret[jss::load] = usage_.balance ();
 
+    ret[jss::bytes_in] = std::to_string (bytesIn_.load ());
+    ret[jss::bytes_out] = std::to_string (bytesOut_.load ());
+    ret[jss::messages_in] = std::to_string (messagesIn_.load ());
+    ret[jss::messages_out] = std::to_string (messagesOut_.load ());
+
     if (hello_.has_fullversion ())
         ret[jss::version] = hello_.fullversion ();
 
@@ -726,12 +736,23 @@ PeerImp::onReadMessage (error_code ec, std::size_t bytes_transferred)
 
     while (read_buffer_.size() > 0)
     {
+        int const type = Message::type (read_buffer_.data ());
+        auto const start = clock_type::now ();
+
         std::size_t bytes_consumed;
         std::tie(bytes_consumed, ec) = invokeProtocolMessage(read_buffer_.data(), *this);
 
         if (ec)
             return fail("onReadMessage", ec);
 
+        if (bytes_consumed != 0)
+        {
+            overlay_.trafficCount ().addIn (
+                type, bytes_consumed, clock_type::now () - start);
+            bytesIn_ += bytes_consumed;
+            ++messagesIn_;
+        }
+
         if (! stream_.next_layer().is_open())
             return;
 
@@ -744,8 +765,20 @@ PeerImp::onReadMessage (error_code ec, std::size_t bytes_transferred)
         read_buffer_.consume (bytes_consumed);
     }
 
+    // If we are part way through a large message, ask for the rest of it
+    // in one read instead of parsing the header again every few kilobytes.
+    std::size_t readBytes = Tuning::readBufferBytes;
+    std::size_t const frameBytes =
+        Message::kHeaderBytes + Message::size (read_buffer_.data ());
+
+    if (frameBytes > read_buffer_.size () + readBytes)
+    {
+        readBytes = std::min<std::size_t> (
+            frameBytes - read_buffer_.size (), Tuning::readBufferMaxBytes);
+    }
+
     // Timeout on writes only
-    stream_.async_read_some (read_buffer_.prepare (Tuning::readBufferBytes),
+    stream_.async_read_some (read_buffer_.prepare (readBytes),
                            strand_.wrap (std::bind (&PeerImp::onReadMessage,
                                                     shared_from_this(),
                                                     std::placeholders::_1,
@@ -754,6 +787,18 @@ PeerImp::onReadMessage (error_code ec, std::size_t bytes_transferred)
                             );
 }
 
+// Called just before the message at the front of the send queue is written
+void
+PeerImp::onWriteStart ()
+{
+    auto const& buffer = send_queue_.front()->getBuffer();
+
+    overlay_.trafficCount ().addOut (Message::getType (buffer),
+        buffer.size (), clock_type::now () - send_times_.front ());
+    bytesOut_ += buffer.size ();
+    ++messagesOut_;
+}
+
 void
 PeerImp::onWriteMessage (error_code ec, std::size_t bytes_transferred)
 {
@@ -777,9 +822,12 @@ PeerImp::onWriteMessage (error_code ec, std::size_t bytes_transferred)
     assert(! send_queue_.empty());
 
     send_queue_.pop();
+    send_times_.pop();
 
     if (! send_queue_.empty())
     {
+        onWriteStart();
+
         // Timeout on writes only
         return boost::asio::async_write (stream_, 
                                         boost::asio::buffer(send_queue_.front()->getBuffer()), 
@@ -1025,7 +1073,13 @@ PeerImp::onMessage (std::shared_ptr<protocol::TMTransaction> const& m)
 
     try
     {
-        STTx::pointer stx = std::make_shared <STTx> (std::ref (sit));
+        // A transaction relayed by several peers is only parsed once
+        Serializer s (m->rawtransaction ().size () + 4);
+        s.add32 (HashPrefix::transactionID);
+        s.addRaw (m->rawtransaction ().data (), m->rawtransaction ().size ());
+
+        STTx::pointer stx = getApp().getMasterTransaction ().parse (
+            s.getSHA512Half (), sit);
         uint256 txID = stx->getTransactionID ();
 
         int flags;
@@ -1250,6 +1304,27 @@ PeerImp::onMessage (std::shared_ptr<protocol::TMProposeSet> const& m)
                                                                         , set.closetime ()
                                                                         , signerPublic, suppression);
 
+    if (isTrusted && set.has_previousledger ())
+    {
+        // The usual case, checked along with other trusted proposals
+        proposal->setPrevLedger (prevLedger);
+
+        std::shared_ptr<PeerImp> self = shared_from_this ();
+        bool const skipCheck = cluster ();
+
+        overlay_.proposalBatch ().add (
+            [proposal, m, skipCheck] ()
+            {
+                return skipCheck || proposal->checkSign (m->signature ());
+            },
+            [self, proposal, m, prevLedger] (bool sigGood)
+            {
+                self->onProposalChecked (m, proposal, prevLedger, sigGood);
+            });
+
+        return;
+    }
+
     getApp().getJobQueue ().addJob (isTrusted ? jtPROPOSAL_t : jtPROPOSAL_ut
                                     , "recvPropose->checkPropose"
                                     , std::bind(&PeerImp::checkPropose, shared_from_this()
@@ -1494,7 +1569,22 @@ PeerImp::onMessage (std::shared_ptr <protocol::TMValidation> const& m)
             p_journal_.debug << "Validation: dropping untrusted from insane peer";
         }
 
-        if (isTrusted || !getApp().getFeeTrack ().isLoadedLocal ())
+        if (isTrusted)
+        {
+            std::shared_ptr<PeerImp> self = shared_from_this ();
+            bool const skipCheck = cluster ();
+
+            overlay_.validationBatch ().add (
+                [val, skipCheck] ()
+                {
+                    return skipCheck || val->isValid (val->getSigningHash ());
+                },
+                [self, val, m] (bool valid)
+                {
+                    self->onValidationChecked (val, m, valid);
+                });
+        }
+        else if (!getApp().getFeeTrack ().isLoadedLocal ())
         {
             getApp().getJobQueue ().addJob (isTrusted ? jtVALIDATION_t : jtVALIDATION_ut
                                         , "recvValidation->checkValidation"
@@ -1585,6 +1675,17 @@ PeerImp::onMessage (std::shared_ptr<protocol::TMGetObjectByHash> const& m)
 
         send (std::make_shared<Message> (reply, protocol::mtGET_OBJECTS));
     }
+    else if ((packet.type () == protocol::TMGetObjectByHash::otFETCH_PACK) &&
+        packet.has_fat () && packet.fat ())
+    {
+        // A catch-up pack covers many ledgers and goes
+        // straight to the node store once it checks out
+        getApp().getJobQueue ().addJob (jtLEDGER_DATA
+                                    , "gotCatchUpPack"
+                                    , std::bind (&NetworkOPs::gotCatchUpPack, &getApp().getOPs ()
+                                               , std::placeholders::_1, std::weak_ptr<PeerImp> (shared_from_this ())
+                                               , m));
+    }
     else
     {
         // this is a reply
@@ -1802,10 +1903,7 @@ PeerImp::checkPropose (Job& job,
 
         if (! cluster() && !proposal->checkSign (set.signature ()))
         {
-            p_journal_.warning << "Proposal with previous ledger fails sig check";
-
-            charge (Resource::feeInvalidSignature);
-
+            onProposalChecked (packet, proposal, prevLedger, false);
             return;
         }
         else
@@ -1848,15 +1946,48 @@ PeerImp::checkPropose (Job& job,
     }
 }
 
+void
+PeerImp::onProposalChecked (std::shared_ptr<protocol::TMProposeSet> const& packet,
+    LedgerProposal::pointer const& proposal, uint256 const& prevLedger,
+        bool sigGood)
+{
+    if (!sigGood)
+    {
+        p_journal_.warning << "Proposal with previous ledger fails sig check";
+
+        charge (Resource::feeInvalidSignature);
+
+        return;
+    }
+
+    getApp().getOPs ().processTrustedProposal (proposal, packet, publicKey_, prevLedger, true);
+}
+
 void
 PeerImp::checkValidation (Job&, STValidation::pointer val,
     bool isTrusted, std::shared_ptr<protocol::TMValidation> const& packet)
+{
+    bool valid = false;
+
+    try
+    {
+        valid = cluster() || val->isValid (val->getSigningHash ());
+    }
+    catch (...)
+    {
+        p_journal_.trace << "Exception checking validation";
+    }
+
+    onValidationChecked (val, packet, valid);
+}
+
+void
+PeerImp::onValidationChecked (STValidation::pointer const& val,
+    std::shared_ptr<protocol::TMValidation> const& packet, bool valid)
 {
     try
     {
-        //  Which functions throw?
-        uint256 signingHash = val->getSigningHash();
-        if (! cluster() && !val->isValid (signingHash))
+        if (!valid)
         {
             p_journal_.warning << "Validation is invalid";
 
@@ -1865,6 +1996,9 @@ PeerImp::checkValidation (Job&, STValidation::pointer val,
             return;
         }
 
+        //  Which functions throw?
+        uint256 signingHash = val->getSigningHash();
+
     #if SKYWELL_HOOK_VALIDATORS
         validatorsConnection_->onValidation(*val);
     #endif
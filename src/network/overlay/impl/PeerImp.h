@@ -38,6 +38,7 @@
 #include <beast/http/message.h>
 #include <beast/http/parser.h>
 #include <beast/utility/WrappedSink.h>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <queue>
@@ -155,6 +156,11 @@ private:
     beast::http::body http_body_;
     beast::asio::streambuf write_buffer_;
     std::queue<Message::pointer> send_queue_;
+    std::queue<clock_type::time_point> send_times_;
+    std::atomic<std::uint64_t> bytesIn_ {0};
+    std::atomic<std::uint64_t> bytesOut_ {0};
+    std::atomic<std::uint64_t> messagesIn_ {0};
+    std::atomic<std::uint64_t> messagesOut_ {0};
     bool gracefulClose_ = false;
     bool recent_empty_ = true;
     std::unique_ptr<LoadEvent> load_event_;
@@ -369,6 +375,10 @@ private:
     void
     onReadMessage (error_code ec, std::size_t bytes_transferred);
 
+    // Called before the next queued message is written
+    void
+    onWriteStart ();
+
     // Called when protocol messages bytes are sent
     void
     onWriteMessage (error_code ec, std::size_t bytes_transferred);
@@ -450,12 +460,23 @@ private:
                 , std::shared_ptr<protocol::TMProposeSet> const& packet
                 , LedgerProposal::pointer proposal);
 
+    void
+    onProposalChecked (std::shared_ptr<protocol::TMProposeSet> const& packet
+                , LedgerProposal::pointer const& proposal
+                , uint256 const& prevLedger
+                , bool sigGood);
+
     void
     checkValidation (Job&
                 , STValidation::pointer val
                 , bool isTrusted
                 , std::shared_ptr<protocol::TMValidation> const& packet);
 
+    void
+    onValidationChecked (STValidation::pointer const& val
+                , std::shared_ptr<protocol::TMValidation> const& packet
+                , bool valid);
+
     void
     getLedger (std::shared_ptr<protocol::TMGetLedger> const&packet);
 
@@ -22,6 +22,7 @@
 
 #include <network/skywell.pb.h>
 #include <network/overlay/Message.h>
+#include <network/overlay/impl/MessagePool.h>
 #include <network/overlay/impl/ZeroCopyStream.h>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/buffers_iterator.hpp>
@@ -71,7 +72,7 @@ invoke (int type, Buffers const& buffers, Handler& handler)
     ZeroCopyInputStream<Buffers> stream(buffers);
     stream.Skip(Message::kHeaderBytes);
 
-    auto const m (std::make_shared<T>());
+    auto const m (makeMessage<T>(Message::size(buffers)));
     if (! m->ParseFromZeroCopyStream(&stream))
         return boost::system::errc::make_error_code(boost::system::errc::invalid_argument);
 
@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <network/overlay/impl/SignatureBatch.h>
+#include <main/Application.h>
+#include <common/base/Log.h>
+#include <common/core/JobQueue.h>
+#include <common/core/ParallelFor.h>
+
+namespace skywell {
+
+enum
+{
+    // Signatures each extra job must have to be worth queueing
+    verifyPerJobMin = 4,
+
+    verifyJobsMax = 8
+};
+
+SignatureBatch::SignatureBatch (JobType type, std::string const& name)
+    : type_ (type)
+    , name_ (name)
+    , scheduled_ (false)
+{
+}
+
+void
+SignatureBatch::add (Verify verify, Complete complete)
+{
+    std::lock_guard <std::mutex> lock (mutex_);
+
+    pending_.push_back ({std::move (verify), std::move (complete)});
+
+    if (scheduled_)
+        return;
+
+    scheduled_ = true;
+
+    getApp().getJobQueue ().addJob (type_, name_, std::bind (
+        &SignatureBatch::run, shared_from_this (), std::placeholders::_1));
+}
+
+void
+SignatureBatch::run (Job&)
+{
+    std::vector <Item> items;
+
+    for (;;)
+    {
+        items.clear ();
+
+        {
+            std::lock_guard <std::mutex> lock (mutex_);
+
+            if (pending_.empty ())
+            {
+                scheduled_ = false;
+                return;
+            }
+
+            std::swap (items, pending_);
+        }
+
+        std::vector <char> good (items.size (), 0);
+
+        parallelFor (getApp().getJobQueue (), type_, name_,
+            items.size (), verifyPerJobMin, verifyJobsMax,
+            [&items, &good] (std::size_t i)
+            {
+                try
+                {
+                    good[i] = items[i].verify () ? 1 : 0;
+                }
+                catch (...)
+                {
+                    WriteLog (lsWARNING, Peer) << "Signature check throws";
+                }
+            });
+
+        for (std::size_t i = 0; i < items.size (); ++i)
+            items[i].complete (good[i] != 0);
+    }
+}
+
+}
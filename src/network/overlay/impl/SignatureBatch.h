@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_OVERLAY_SIGNATUREBATCH_H_INCLUDED
+#define SKYWELL_OVERLAY_SIGNATUREBATCH_H_INCLUDED
+
+#include <common/core/Job.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace skywell {
+
+/** Verifies the signatures on proposals and validations in batches.
+
+    Work added while a batch is queued or running joins the next batch
+    instead of getting its own job, so a burst of messages at the end of
+    a round takes one job at a time. The signatures in a batch are
+    checked on several threads, then the results are handled one after
+    another on the job's thread, so the handlers take the master lock
+    back to back instead of contending for it.
+*/
+class SignatureBatch
+    : public std::enable_shared_from_this <SignatureBatch>
+{
+public:
+    /** Checks a signature, may be called on any thread. */
+    using Verify = std::function <bool ()>;
+
+    /** Handles the result of the check, called in the order added. */
+    using Complete = std::function <void (bool)>;
+
+    SignatureBatch (JobType type, std::string const& name);
+
+    SignatureBatch (SignatureBatch const&) = delete;
+    SignatureBatch& operator= (SignatureBatch const&) = delete;
+
+    void
+    add (Verify verify, Complete complete);
+
+private:
+    struct Item
+    {
+        Verify verify;
+        Complete complete;
+    };
+
+    void
+    run (Job&);
+
+    JobType const type_;
+    std::string const name_;
+
+    std::mutex mutex_;
+    std::vector <Item> pending_;
+    bool scheduled_;
+};
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <network/overlay/impl/TrafficCount.h>
+#include <network/overlay/impl/ProtocolMessage.h>
+#include <protocol/JsonFields.h>
+#include <functional>
+#include <type_traits>
+
+namespace skywell {
+
+// The message types we report to the collector
+static int const reportedTypes[] =
+{
+    protocol::mtHELLO,
+    protocol::mtPING,
+    protocol::mtCLUSTER,
+    protocol::mtGET_PEERS,
+    protocol::mtPEERS,
+    protocol::mtENDPOINTS,
+    protocol::mtTRANSACTION,
+    protocol::mtGET_LEDGER,
+    protocol::mtLEDGER_DATA,
+    protocol::mtPROPOSE_LEDGER,
+    protocol::mtSTATUS_CHANGE,
+    protocol::mtHAVE_SET,
+    protocol::mtVALIDATION,
+    protocol::mtGET_OBJECTS
+};
+
+TrafficCount::TrafficCount (beast::insight::Collector::ptr const& collector)
+{
+    gauges_.reserve (std::extent<decltype(reportedTypes)>::value);
+
+    for (int type : reportedTypes)
+    {
+        std::string const prefix ("traffic." + protocolMessageName (type));
+
+        gauges_.push_back ({type
+            , collector->make_gauge (prefix, "messages_in")
+            , collector->make_gauge (prefix, "bytes_in")
+            , collector->make_gauge (prefix, "messages_out")
+            , collector->make_gauge (prefix, "bytes_out")
+            , collector->make_gauge (prefix, "handler_us")
+            , collector->make_gauge (prefix, "queue_us")});
+    }
+
+    hook_ = collector->make_hook (std::bind (
+        &TrafficCount::collect_metrics, this));
+}
+
+void
+TrafficCount::addIn (int type, std::size_t bytes, clock_type::duration handler)
+{
+    Stats& stats = stats_[index (type)];
+
+    ++stats.messagesIn;
+    stats.bytesIn += bytes;
+    stats.handlerMicros += std::chrono::duration_cast<
+        std::chrono::microseconds> (handler).count ();
+}
+
+void
+TrafficCount::addOut (int type, std::size_t bytes, clock_type::duration queued)
+{
+    Stats& stats = stats_[index (type)];
+
+    ++stats.messagesOut;
+    stats.bytesOut += bytes;
+    stats.queueMicros += std::chrono::duration_cast<
+        std::chrono::microseconds> (queued).count ();
+}
+
+void
+TrafficCount::collect_metrics ()
+{
+    for (auto const& g : gauges_)
+    {
+        Stats const& stats = stats_[index (g.type)];
+
+        g.messagesIn.set (stats.messagesIn.load ());
+        g.bytesIn.set (stats.bytesIn.load ());
+        g.messagesOut.set (stats.messagesOut.load ());
+        g.bytesOut.set (stats.bytesOut.load ());
+        g.handlerMicros.set (stats.handlerMicros.load ());
+        g.queueMicros.set (stats.queueMicros.load ());
+    }
+}
+
+Json::Value
+TrafficCount::json () const
+{
+    Json::Value ret (Json::objectValue);
+
+    for (std::size_t type = 0; type < maxType; ++type)
+    {
+        Stats const& stats = stats_[type];
+
+        std::uint64_t const messagesIn = stats.messagesIn.load ();
+        std::uint64_t const messagesOut = stats.messagesOut.load ();
+
+        if ((messagesIn == 0) && (messagesOut == 0))
+            continue;
+
+        Json::Value& entry = ret[protocolMessageName (type)];
+
+        entry[jss::messages_in] = std::to_string (messagesIn);
+        entry[jss::bytes_in] = std::to_string (stats.bytesIn.load ());
+        entry[jss::messages_out] = std::to_string (messagesOut);
+        entry[jss::bytes_out] = std::to_string (stats.bytesOut.load ());
+
+        if (messagesIn != 0)
+        {
+            entry[jss::handler_us] = static_cast<Json::UInt> (
+                stats.handlerMicros.load () / messagesIn);
+        }
+
+        if (messagesOut != 0)
+        {
+            entry[jss::queue_us] = static_cast<Json::UInt> (
+                stats.queueMicros.load () / messagesOut);
+        }
+    }
+
+    return ret;
+}
+
+} // skywell
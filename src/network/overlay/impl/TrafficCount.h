@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_OVERLAY_TRAFFICCOUNT_H_INCLUDED
+#define SKYWELL_OVERLAY_TRAFFICCOUNT_H_INCLUDED
+
+#include <common/json/json_value.h>
+#include <beast/Insight.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace skywell {
+
+/** Accounts for overlay traffic by protocol message type.
+
+    For every message type this records the messages and bytes received
+    and sent, the time spent in the handler that dispatches a received
+    message, and the time a message we send waits in a peer's send queue
+    before it goes out. The totals are reported through the insight
+    collector and as JSON for the traffic_info command.
+
+    All the counters are atomic, so any peer can update them from its
+    own strand without locking.
+*/
+class TrafficCount
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    explicit
+    TrafficCount (beast::insight::Collector::ptr const& collector);
+
+    TrafficCount (TrafficCount const&) = delete;
+    TrafficCount& operator= (TrafficCount const&) = delete;
+
+    /** Record a message we received, with the time its handler took. */
+    void
+    addIn (int type, std::size_t bytes, clock_type::duration handler);
+
+    /** Record a message we sent, with the time it was queued. */
+    void
+    addOut (int type, std::size_t bytes, clock_type::duration queued);
+
+    /** Returns the totals for every message type we have seen. */
+    Json::Value
+    json () const;
+
+private:
+    // Message types are small integers, so a table indexed by type
+    // avoids any lookup on the hot path. Unknown and out of range
+    // types share the first slot.
+    static std::size_t const maxType = 64;
+
+    struct Stats
+    {
+        std::atomic<std::uint64_t> messagesIn {0};
+        std::atomic<std::uint64_t> bytesIn {0};
+        std::atomic<std::uint64_t> messagesOut {0};
+        std::atomic<std::uint64_t> bytesOut {0};
+        std::atomic<std::uint64_t> handlerMicros {0};
+        std::atomic<std::uint64_t> queueMicros {0};
+    };
+
+    struct Gauges
+    {
+        int type;
+        beast::insight::Gauge messagesIn;
+        beast::insight::Gauge bytesIn;
+        beast::insight::Gauge messagesOut;
+        beast::insight::Gauge bytesOut;
+        beast::insight::Gauge handlerMicros;
+        beast::insight::Gauge queueMicros;
+    };
+
+    static
+    std::size_t
+    index (int type)
+    {
+        return ((type > 0) && (type < static_cast<int> (maxType))) ? type : 0;
+    }
+
+    void
+    collect_metrics ();
+
+    std::array<Stats, maxType> stats_;
+    std::vector<Gauges> gauges_;
+    beast::insight::Hook hook_;
+};
+
+} // skywell
+
+#endif
@@ -30,6 +30,9 @@ enum
     /** Size of buffer used to read from the socket. */
     readBufferBytes     = 4096,
 
+    /** Largest single read we do to finish a partly received message. */
+    readBufferMaxBytes  = 262144,
+
     /** How long a server can remain insane before we
         disconnected it (if outbound) */
     maxInsaneTime       =   60,
@@ -52,6 +55,12 @@ enum
 
     /** How often we check connections (seconds) */
     checkSeconds        =   10,
+
+    /** How many recycled message objects we keep per type */
+    pooledMessageCount  =  256,
+
+    /** Largest message whose object we recycle (bytes) */
+    pooledMessageBytes  = 65536,
 };
 
 } // Tuning
@@ -25,6 +25,7 @@
 #include <network/resource/Manager.h>
 #include <common/base/Resolver.h>
 #include <beast/threads/Stoppable.h>
+#include <beast/Insight.h>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ssl/context.hpp>
 
@@ -41,7 +42,8 @@ make_Overlay (Overlay::Setup const& setup
             , Resource::Manager& resourceManager
             , Resolver& resolver
             , boost::asio::io_service& io_service
-            , BasicConfig const& config);
+            , BasicConfig const& config
+            , beast::insight::Collector::ptr const& collector);
 
 } // skywell
 
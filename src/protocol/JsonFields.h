@@ -72,11 +72,14 @@ JSS ( accounts );                   // in: LedgerEntry, Subscribe,
                                     // out: WalletAccounts
 JSS ( accounts_proposed );          // in: Subscribe, Unsubscribe
 JSS ( action );                     // out: LedgerEntrySet
+JSS ( adaptive );                   // out: AdaptiveLedgerTiming
 JSS ( address );                    // out: PeerImp
+JSS ( add_links_us );               // out: PathFindReplay
 JSS ( affected );                   // out: AcceptedLedgerTx
 JSS ( age );                        // out: UniqueNodeList, NetworkOPs
 JSS ( alternatives );               // out: PathRequest, SkywellPathFind
 JSS ( amendment_blocked );          // out: NetworkOPs
+JSS ( apply_time );                 // out: AdaptiveLedgerTiming
 JSS ( asks );                       // out: Subscribe
 JSS ( authorized );                 // out: AccountLines
 JSS ( balance );                    // out: AccountLines
@@ -91,9 +94,12 @@ JSS ( both );                       // in: Subscribe, Unsubscribe
 JSS ( both_sides );                 // in: Subscribe, Unsubscribe
 JSS ( build_path );                 // in: TransactionSign
 JSS ( build_version );              // out: NetworkOPs
+JSS ( bytes_in );                   // out: PeerImp, TrafficCount
+JSS ( bytes_out );                  // out: PeerImp, TrafficCount
 JSS ( can_delete );                 // out: CanDelete
 JSS ( check_nodes );                // in: LedgerCleaner
 JSS ( clear );                      // in/out: FetchInfo
+JSS ( close_interval );             // out: AdaptiveLedgerTiming
 JSS ( close_time );                 // in: Application, out: NetworkOPs,
                                     //      LedgerProposal, LedgerToJson
 JSS ( close_time_estimated );       // in: Application, out: LedgerToJson
@@ -110,7 +116,7 @@ JSS ( comment );                    // in: UnlAdd
 JSS ( complete );                   // out: NetworkOPs, InboundLedger
 JSS ( complete_ledgers );           // out: NetworkOPs, PeerImp
 JSS ( consensus );                  // out: NetworkOPs, LedgerConsensus
-JSS ( converge_time );              // out: NetworkOPs
+JSS ( converge_time );              // out: NetworkOPs, AdaptiveLedgerTiming
 JSS ( converge_time_s );            // out: NetworkOPs
 JSS ( count );                      // in: AccountTx*
 JSS ( currency );                   // in: paths/PathRequest, STAmount
@@ -123,6 +129,7 @@ JSS ( dbKBTotal );                  // out: getCounts
 JSS ( dbKBTransaction );            // out: getCounts
 JSS ( debug_signing );              // in: TransactionSign
 JSS ( delivered_amount );           // out: addPaymentDeliveredAmount
+JSS ( delta );                      // in: Subscribe
 JSS ( deprecated );                 // out: WalletSeed
 JSS ( descending );                 // in: AccountTx*
 JSS ( destination_account );        // in: PathRequest, SkywellPathFind
@@ -149,6 +156,7 @@ JSS ( fee_base );                   // out: NetworkOPs
 JSS ( fee_mult_max );               // in: TransactionSign
 JSS ( fee_ref );                    // out: NetworkOPs
 JSS ( fetch_pack );                 // out: NetworkOPs
+JSS ( file );                       // in: PathFindReplay
 JSS ( first );                      // out: rpc/Version
 JSS ( fix_txns );                   // in: LedgerCleaner
 JSS ( flags );                      // out: paths/Node, AccountOffers
@@ -159,6 +167,7 @@ JSS ( full );                       // in: LedgerClearer, handlers/Ledger
 JSS ( fullbelow_size );             // in: GetCounts
 JSS ( generator );                  // in: LedgerEntry
 JSS ( good );                       // out: RPCVersion
+JSS ( handler_us );                 // out: TrafficCount
 JSS ( hash );                       // out: NetworkOPs, InboundLedger,
                                     //      LedgerToJson, STTx; field
 JSS ( have_header );                // out: InboundLedger
@@ -184,6 +193,7 @@ JSS ( issuer );                     // in: SkywellPathFind, Subscribe,
 JSS ( key );                        // out: WalletSeed
 JSS ( key_type );                   // in/out: WalletPropose, TransactionSign
 JSS ( latency );                    // out: PeerImp
+JSS ( latency_ms );                 // out: PathFindReplay
 JSS ( last );                       // out: RPCVersion
 JSS ( last_close );                 // out: NetworkOPs
 JSS ( ledger );                     // in: NetworkOPs, LedgerCleaner,
@@ -204,6 +214,7 @@ JSS ( ledger_index_min );           // in, out: AccountTx*
 JSS ( ledger_max );                 // in, out: AccountTx*
 JSS ( ledger_min );                 // in, out: AccountTx*
 JSS ( ledger_time );                // out: NetworkOPs
+JSS ( ledger_timing );              // out: NetworkOPs
 JSS ( levels );                     // LogLevels
 JSS ( limit );                      // in/out: AccountTx*, AccountOffers,
                                     //         AccountLines, AccountObjects
@@ -211,6 +222,9 @@ JSS ( limit );                      // in/out: AccountTx*, AccountOffers,
 JSS ( relation_type);                 // out:AccountRelation
 JSS ( limit_peer );                 // out: AccountLines
 JSS ( lines );                      // out: AccountLines
+JSS ( liquidity_cached );           // out: PathFindReplay
+JSS ( liquidity_checks );           // out: PathFindReplay
+JSS ( liquidity_us );               // out: PathFindReplay
 JSS ( load );                       // out: NetworkOPs, PeerImp
 JSS ( load_base );                  // out: NetworkOPs
 JSS ( load_factor );                // out: NetworkOPs
@@ -228,11 +242,15 @@ JSS ( master_key );                 // out: WalletPropose
 JSS ( master_seed );                // out: WalletPropose
 JSS ( master_seed_hex );            // out: WalletPropose
 JSS ( max_ledger );                 // in/out: LedgerCleaner
+JSS ( max_size );                   // out: TxQ
 JSS ( message );                    // error.
+JSS ( messages_in );                // out: PeerImp, TrafficCount
+JSS ( messages_out );               // out: PeerImp, TrafficCount
 JSS ( meta );                       // out: NetworkOPs, AccountTx*, Tx
 JSS ( metaData );                   // out: LedgerEntrySet, LedgerToJson
 JSS ( metadata );                   // out: TransactionEntry
 JSS ( method );                     // RPC
+JSS ( min_consensus );              // out: AdaptiveLedgerTiming
 JSS ( min_count );                  // in: GetCounts
 JSS ( min_ledger );                 // in: LedgerCleaner
 JSS ( missingCommand );             // error
@@ -267,6 +285,7 @@ JSS ( partition );                  // in: LogLevel
 JSS ( passphrase );                 // in: WalletPropose
 JSS ( password );                   // in: Subscribe
 JSS ( paths );                      // in: SkywellPathFind
+JSS ( paths_explored );             // out: PathFindReplay
 JSS ( paths_canonical );            // out: SkywellPathFind
 JSS ( paths_computed );             // out: PathRequest, SkywellPathFind
 JSS ( peer );                       // in: AccountLines
@@ -277,6 +296,7 @@ JSS ( peers );                      // out: InboundLedger, handlers/Peers
 JSS ( port );                       // in: Connect
 JSS ( previous_ledger );            // out: LedgerPropose
 JSS ( proof );                      // in: BookOffers
+JSS ( propose_delay );              // out: AdaptiveLedgerTiming
 JSS ( propose_seq );                // out: LedgerPropose
 JSS ( proposers );                  // out: NetworkOPs, LedgerConsensus
 JSS ( protocol );                   // out: PeerImp
@@ -288,12 +308,15 @@ JSS ( published_ledger );           // out: NetworkOPs
 JSS ( quality );                    // out: NetworkOPs
 JSS ( quality_in );                 // out: AccountLines
 JSS ( quality_out );                // out: AccountLines
+JSS ( queue );                      // out: NetworkOPs
+JSS ( queue_us );                   // out: TrafficCount
 JSS ( random );                     // out: Random
 JSS ( raw_meta );                   // out: AcceptedLedgerTx
 JSS ( receive_currencies );         // out: AccountCurrencies
 JSS ( regular_seed );               // in/out: LedgerEntry
 JSS ( remote );                     // out: Logic.h
 JSS ( request );                    // RPC
+JSS ( requests );                   // in/out: PathFindReplay
 JSS ( reserve_base );               // out: NetworkOPs
 JSS ( reserve_base_swt );           // out: NetworkOPs
 JSS ( reserve_inc );                // out: NetworkOPs
@@ -312,6 +335,7 @@ JSS ( skywell_state );              // in: LedgerEntr
 JSS ( rt_accounts );                // in: Subscribe, Unsubscribe
 JSS ( sanity );                     // out: PeerImp
 JSS ( search_depth );               // in: SkywellPathFind
+JSS ( search_mode );                // in: SkywellPathFind, PathRequest
 JSS ( secret );                     // in: TransactionSign, WalletSeed,
                                     //     ValidationCreate, ValidationSeed
 JSS ( seed );                       // in: WalletAccounts, out: WalletSeed
@@ -349,6 +373,7 @@ JSS ( threshold );                  // in: Blacklist
 JSS ( timeouts );                   // out: InboundLedger
 JSS ( totalCoins );                 // out: LedgerToJson
 JSS ( total_coins );                // out: LedgerToJson
+JSS ( traffic );                    // out: TrafficInfo
 JSS ( transTreeHash );              // out: ledger/Ledger.cpp
 JSS ( transaction );                // in: Tx
                                     // out: NetworkOPs, AcceptedLedgerTx,
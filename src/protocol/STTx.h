@@ -23,8 +23,8 @@
 #include <protocol/STObject.h>
 #include <protocol/TxFormats.h>
 #include <protocol/STArray.h>
-#include <boost/logic/tribool.hpp>
 #include <common/base/Log.h>
+#include <atomic>
 #include <set>
 
 namespace skywell {
@@ -51,7 +51,13 @@ public:
     STTx () = delete;
     STTx& operator= (STTx const& other) = delete;
 
-    STTx (STTx const& other) = default;
+    STTx (STTx const& other)
+        : STObject (other)
+        , CountedObject <STTx> (other)
+        , tx_type_ (other.tx_type_)
+        , sig_state_ (other.sig_state_.load ())
+    {
+    }
 
     explicit STTx (SerialIter& sit);
     explicit STTx (TxType type);
@@ -193,19 +199,19 @@ public:
 
     bool isKnownGood () const
     {
-        return (sig_state_ == true);
+        return (sig_state_ == sigGood);
     }
     bool isKnownBad () const
     {
-        return (sig_state_ == false);
+        return (sig_state_ == sigBad);
     }
     void setGood () const
     {
-        sig_state_ = true;
+        sig_state_ = sigGood;
     }
     void setBad () const
     {
-        sig_state_ = false;
+        sig_state_ = sigBad;
     }
 
     // SQL Functions with metadata
@@ -225,7 +231,16 @@ public:
 private:
     TxType tx_type_;
 
-    mutable boost::tribool sig_state_;
+    enum
+    {
+        sigUnknown,
+        sigGood,
+        sigBad
+    };
+
+    // Parsed transactions are shared between threads, which may all
+    // check the signature
+    mutable std::atomic<int> sig_state_;
 };
 
 bool passesLocalChecks(STObject const& st, std::string&);
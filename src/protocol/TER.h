@@ -143,6 +143,7 @@ enum TER    // aka TransactionEngineResult
                          // burden network.
     terLAST,             // Process after all other transactions
     terNO_SKYWELL,        // Rippling not allowed
+    terQUEUED,           // Held in the transaction queue for a later ledger
 
     // 0: S Success (success)
     // Causes:
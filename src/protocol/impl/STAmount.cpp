@@ -19,7 +19,6 @@
 
 #include <BeastConfig.h>
 #include <common/base/Log.h>
-#include <crypto/CBigNum.h>
 #include <protocol/JsonFields.h>
 #include <protocol/SystemParameters.h>
 #include <protocol/STAmount.h>
@@ -28,6 +27,7 @@
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
 #include <iostream>
+#include <limits>
 #include <common/misc/Utility.h>
 
 namespace skywell {
@@ -36,6 +36,68 @@ static const std::uint64_t tenTo14 = 100000000000000ull;
 static const std::uint64_t tenTo14m1 = tenTo14 - 1;
 static const std::uint64_t tenTo17 = tenTo14 * 1000;
 
+// Computes (a * b + c) / d without rounding, forming the intermediate
+// value at 128 bits. A quotient too large for 64 bits saturates to the
+// largest value, which is what the bignum implementation returned.
+static
+std::uint64_t
+muldiv (std::uint64_t a, std::uint64_t b, std::uint64_t c, std::uint64_t d)
+{
+    assert (d != 0);
+
+#if defined (__SIZEOF_INT128__)
+    using uint128_t = unsigned __int128;
+
+    uint128_t const q = (static_cast<uint128_t> (a) * b + c) / d;
+
+    if ((q >> 64) != 0)
+        return std::numeric_limits<std::uint64_t>::max ();
+
+    return static_cast<std::uint64_t> (q);
+#else
+    std::uint64_t const mask = 0xffffffffull;
+
+    // 64x64 multiply from 32 bit halves
+    std::uint64_t const ll = (a & mask) * (b & mask);
+    std::uint64_t const lh = (a & mask) * (b >> 32);
+    std::uint64_t const hl = (a >> 32) * (b & mask);
+    std::uint64_t const hh = (a >> 32) * (b >> 32);
+
+    std::uint64_t const mid = (ll >> 32) + (lh & mask) + (hl & mask);
+
+    std::uint64_t lo = (mid << 32) | (ll & mask);
+    std::uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+    lo += c;
+    if (lo < c)
+        ++hi;
+
+    if (hi >= d)
+        return std::numeric_limits<std::uint64_t>::max ();
+
+    // Long division, one bit at a time. The remainder always fits in
+    // 64 bits plus the bit shifted out the top.
+    std::uint64_t rem = hi;
+    std::uint64_t q = 0;
+
+    for (int i = 63; i >= 0; --i)
+    {
+        bool const carry = (rem >> 63) != 0;
+
+        rem = (rem << 1) | ((lo >> i) & 1);
+        q <<= 1;
+
+        if (carry || (rem >= d))
+        {
+            rem -= d;
+            q |= 1;
+        }
+    }
+
+    return q;
+#endif
+}
+
 STAmount const saZero (noIssue(), 0u);
 STAmount const saOne (noIssue(), 1u);
 
@@ -1164,20 +1226,11 @@ divide (STAmount const& num, STAmount const& den, Issue const& issue)
     }
 
     // Compute (numerator * 10^17) / denominator
-    CBigNum v;
-
-    if ((BN_add_word64 (&v, numVal) != 1) ||
-            (BN_mul_word64 (&v, tenTo17) != 1) ||
-            (BN_div_word64 (&v, denVal) == ((std::uint64_t) - 1)))
-    {
-        throw std::runtime_error ("internal bn error");
-    }
-
     // 10^16 <= quotient <= 10^18
-    assert (BN_num_bytes (&v) <= 64);
+    std::uint64_t const v = muldiv (numVal, tenTo17, 0, denVal);
 
     // TODO(tom): where do 5 and 17 come from?
-    return STAmount (issue, v.getuint64 () + 5,
+    return STAmount (issue, v + 5,
                      numOffset - denOffset - 17,
                      num.negative() != den.negative());
 }
@@ -1229,20 +1282,10 @@ multiply (STAmount const& v1, STAmount const& v2, Issue const& issue)
 
     // Compute (numerator * denominator) / 10^14 with rounding
     // 10^16 <= result <= 10^18
-    CBigNum v;
-
-    if ((BN_add_word64 (&v, value1) != 1) ||
-            (BN_mul_word64 (&v, value2) != 1) ||
-            (BN_div_word64 (&v, tenTo14) == ((std::uint64_t) - 1)))
-    {
-        throw std::runtime_error ("internal bn error");
-    }
-
-    // 10^16 <= product <= 10^18
-    assert (BN_num_bytes (&v) <= 64);
+    std::uint64_t const v = muldiv (value1, value2, 0, tenTo14);
 
     // TODO(tom): where do 7 and 14 come from?
-    return STAmount (issue, v.getuint64 () + 7,
+    return STAmount (issue, v + 7,
         offset1 + offset2 + 14, v1.negative() != v2.negative());
 }
 
@@ -1338,21 +1381,10 @@ mulRound (STAmount const& v1, STAmount const& v2,
     bool resultNegative = v1.negative() != v2.negative();
     // Compute (numerator * denominator) / 10^14 with rounding
     // 10^16 <= result <= 10^18
-    CBigNum v;
-
-    if ((BN_add_word64 (&v, value1) != 1) || (BN_mul_word64 (&v, value2) != 1))
-        throw std::runtime_error ("internal bn error");
-
-    if (resultNegative != roundUp) // rounding down is automatic when we divide
-        BN_add_word64 (&v, tenTo14m1);
-
-    if  (BN_div_word64 (&v, tenTo14) == ((std::uint64_t) - 1))
-        throw std::runtime_error ("internal bn error");
-
-    // 10^16 <= product <= 10^18
-    assert (BN_num_bytes (&v) <= 64);
+    // Rounding down is automatic when we divide
+    std::uint64_t amount = muldiv (value1, value2,
+        (resultNegative != roundUp) ? tenTo14m1 : 0, tenTo14);
 
-    std::uint64_t amount = v.getuint64 ();
     int offset = offset1 + offset2 + 14;
     canonicalizeRound (
         isSWT (issue), amount, offset, resultNegative != roundUp);
@@ -1389,21 +1421,11 @@ divRound (STAmount const& num, STAmount const& den,
 
     bool resultNegative = num.negative() != den.negative();
     // Compute (numerator * 10^17) / denominator
-    CBigNum v;
-
-    if ((BN_add_word64 (&v, numVal) != 1) || (BN_mul_word64 (&v, tenTo17) != 1))
-        throw std::runtime_error ("internal bn error");
-
-    if (resultNegative != roundUp) // Rounding down is automatic when we divide
-        BN_add_word64 (&v, denVal - 1);
-
-    if (BN_div_word64 (&v, denVal) == ((std::uint64_t) - 1))
-        throw std::runtime_error ("internal bn error");
-
     // 10^16 <= quotient <= 10^18
-    assert (BN_num_bytes (&v) <= 64);
+    // Rounding down is automatic when we divide
+    std::uint64_t amount = muldiv (numVal, tenTo17,
+        (resultNegative != roundUp) ? (denVal - 1) : 0, denVal);
 
-    std::uint64_t amount = v.getuint64 ();
     int offset = numOffset - denOffset - 17;
     canonicalizeRound (
         isSWT (issue), amount, offset, resultNegative != roundUp);
@@ -35,7 +35,7 @@ namespace skywell {
 STTx::STTx (TxType type)
     : STObject (sfTransaction)
     , tx_type_ (type)
-    , sig_state_ (boost::indeterminate)
+    , sig_state_ (sigUnknown)
 {
     auto format = TxFormats::getInstance().findByType (type);
 
@@ -52,7 +52,7 @@ STTx::STTx (TxType type)
 
 STTx::STTx (STObject&& object)
     : STObject (std::move (object))
-    , sig_state_ (boost::indeterminate)
+    , sig_state_ (sigUnknown)
 {
     tx_type_ = static_cast <TxType> (getFieldU16 (sfTransactionType));
     auto format = TxFormats::getInstance().findByType (tx_type_);
@@ -74,7 +74,7 @@ STTx::STTx (STObject&& object)
 
 STTx::STTx (SerialIter& sit)
     : STObject (sfTransaction)
-    , sig_state_ (boost::indeterminate)
+    , sig_state_ (sigUnknown)
 {
     int length = sit.getBytesLeft ();
 
@@ -273,8 +273,12 @@ void STTx::sign(
 
 bool STTx::checkSign() const
 {
-    if (boost::indeterminate(sig_state_))
+    int state = sig_state_;
+
+    if (state == sigUnknown)
     {
+        bool good = false;
+
         try
         {
             ECDSA const fullyCanonical = (getFlags() & tfFullyCanonicalSig)
@@ -284,34 +288,35 @@ bool STTx::checkSign() const
             SkywellAddress n;
             n.setAccountPublic(getFieldVL(sfSigningPubKey));
 
-            sig_state_ = n.accountPublicVerify(getSigningData(*this),
+            good = n.accountPublicVerify(getSigningData(*this),
                 getFieldVL(sfTxnSignature), fullyCanonical);
 
-            if (!sig_state_)
-                throw std::runtime_error(transHuman(temBAD_SIGNATURE));
-
-            if (getTxnType() == ttOPERATION)
+            if (good && (getTxnType() == ttOPERATION))
             {
                auto const & SigningData = getSigningData(*this);
                STArray tSigns = getFieldArray(sfSigns);
                for (STObject const& tSign : tSigns)
                {
                    n.setAccountPublic(tSign.getFieldVL(sfSigningPubKey));
-                   sig_state_ = n.accountPublicVerify(SigningData,
+                   good = n.accountPublicVerify(SigningData,
                        tSign.getFieldVL(sfTxnSignature), fullyCanonical);
-                   if (!sig_state_)
-                       throw std::runtime_error(transHuman(temBAD_SIGNATURE));
+                   if (!good)
+                       break;
                }
             }
         }
         catch (...)
         {
-            sig_state_ = false;
+            good = false;
         }
+
+        // Only the final result is published, a thread checking at the
+        // same time reaches the same one
+        state = good ? sigGood : sigBad;
+        sig_state_ = state;
     }
-    assert(!boost::indeterminate(sig_state_));
 
-    return static_cast<bool> (sig_state_);
+    return state == sigGood;
 }
 
 void STTx::setSigningPubKey (SkywellAddress const& naSignPubKey)
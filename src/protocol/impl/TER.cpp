@@ -135,6 +135,7 @@ bool transResultInfo (TER code, std::string& token, std::string& text)
         { terNO_AUTH,               "terNO_AUTH",               "Not authorized to hold IOUs."                                  },
         { terNO_LINE,               "terNO_LINE",               "No such line."                                                 },
         { terPRE_SEQ,               "terPRE_SEQ",               "Missing/inapplicable prior transaction."                       },
+        { terQUEUED,                "terQUEUED",                "Held until a later open ledger can take it."                   },
         { terOWNERS,                "terOWNERS",                "Non-zero owner count."                                         },
 
         { tesSUCCESS,               "tesSUCCESS",               "The transaction was applied. Only final in a validated ledger." },
@@ -87,7 +87,7 @@ public:
         virtual bool subServer (ref ispListener, Json::Value& jvResult, bool admin) = 0;
         virtual bool unsubServer (std::uint64_t uListener) = 0;
 
-        virtual bool subBook (ref ispListener, Book const&) = 0;
+        virtual bool subBook (ref ispListener, Book const&, bool delta) = 0;
         virtual bool unsubBook (std::uint64_t uListener, Book const&) = 0;
 
         virtual bool subTransactions (ref ispListener) = 0;
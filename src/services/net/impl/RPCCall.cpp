@@ -775,6 +775,22 @@ private:
         return rpcError (rpcINVALID_PARAMS);
     }
 
+    // path_find_replay <file> [<ledger>]
+    Json::Value parsePathFindReplay (Json::Value const& jvParams)
+    {
+        Json::Value jvRequest;
+
+        jvRequest[jss::file] = jvParams[0u].asString ();
+
+        if (jvParams.size () == 2
+            && !jvParseLedger (jvRequest, jvParams[1u].asString ()))
+        {
+            return rpcError (rpcLGR_IDX_MALFORMED);
+        }
+
+        return jvRequest;
+    }
+
     // sign/submit any transaction to the network
     //
     // sign <private_key> <json> offline
@@ -1014,6 +1030,7 @@ public:
 			{ "nickname_info",           &RPCParser::parseNickName,              1,  2 },
 
             {   "owner_info",           &RPCParser::parseAccountItems,          1,  2   },
+            {   "path_find_replay",     &RPCParser::parsePathFindReplay,        1,  2   },
             {   "peers",                &RPCParser::parseAsIs,                  0,  0   },
             {   "ping",                 &RPCParser::parseAsIs,                  0,  0   },
             {   "print",                &RPCParser::parseAsIs,                  0,  1   },
@@ -1032,6 +1049,7 @@ public:
             {   "stop",                 &RPCParser::parseAsIs,                  0,  0   },
     //      {   "transaction_entry",    &RPCParser::parseTransactionEntry,     -1,  -1  },
             {   "thread_info",          &RPCParser::parseTreadInfo,             0,  2   },
+            {   "traffic_info",         &RPCParser::parseAsIs,                  0,  0   },
             {   "tx",                   &RPCParser::parseTx,                    1,  2   },
             {   "tx_account",           &RPCParser::parseTxAccount,             1,  7   },
             {   "tx_history",           &RPCParser::parseTxHistory,             1,  1   },
@@ -18,9 +18,10 @@
 //==============================================================================
 
 #include <BeastConfig.h>
+#include <main/Application.h>
 #include <services/rpc/impl/AccountFromString.h>
 #include <services/rpc/impl/LookupLedger.h>
-#include <transaction/paths/SkywellState.h>
+#include <transaction/paths/PathRequests.h>
 
 namespace skywell {
 
@@ -65,19 +66,26 @@ Json::Value doAccountCurrencies (RPC::Context& context)
         return jvAccepted;
 
     std::set<Currency> send, receive;
-    for (auto const& item : getSkywellStateItems (naAccount.getAccountID (), ledger))
+
+    // Only read the pathfinding line cache, and only if it was already
+    // built for this ledger. Anything else is worked out in a cache of its
+    // own, so a public request can't replace or grow the shared one.
+    std::shared_ptr <SkywellLineCache::AccountCurrencies const> currencies;
+
+    if (ledger->isClosed ())
     {
-        SkywellState* rspEntry = (SkywellState*) item.get ();
-        STAmount const& saBalance = rspEntry->getBalance ();
+        if (auto cache = getApp().getPathRequests().peekLineCache (ledger))
+            currencies = cache->findAccountCurrencies (naAccount.getAccountID ());
+    }
 
-        if (saBalance < rspEntry->getLimit ())
-            receive.insert (saBalance.getCurrency ());
-        if ((-saBalance) < rspEntry->getLimitPeer ())
-            send.insert (saBalance.getCurrency ());
+    if (!currencies)
+    {
+        auto cache = std::make_shared<SkywellLineCache> (ledger);
+        currencies = cache->getAccountCurrencies (naAccount.getAccountID ());
     }
 
-    send.erase (badCurrency());
-    receive.erase (badCurrency());
+    send.insert (currencies->send.begin (), currencies->send.end ());
+    receive.insert (currencies->receive.begin (), currencies->receive.end ());
 
     Json::Value& sendCurrencies =
             (result[jss::send_currencies] = Json::arrayValue);
@@ -55,6 +55,7 @@ Json::Value doNicknameInfo          (RPC::Context&);
 Json::Value doNoSkywellCheck         (RPC::Context&);
 Json::Value doOwnerInfo             (RPC::Context&);
 Json::Value doPathFind              (RPC::Context&);
+Json::Value doPathFindReplay        (RPC::Context&);
 Json::Value doPeers                 (RPC::Context&);
 Json::Value doPing                  (RPC::Context&);
 Json::Value doPrint                 (RPC::Context&);
@@ -75,6 +76,7 @@ Json::Value doShowBlob              (RPC::Context&); //
 Json::Value doShowTrust             (RPC::Context&);
 Json::Value doTransactionEntry      (RPC::Context&);
 Json::Value doThreadInfo            (RPC::Context&);
+Json::Value doTrafficInfo           (RPC::Context&);
 Json::Value doTx                    (RPC::Context&);
 Json::Value doTxHistory             (RPC::Context&);
 Json::Value doUnlAdd                (RPC::Context&);
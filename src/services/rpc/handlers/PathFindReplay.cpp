@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012-2014 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <main/Application.h>
+#include <services/rpc/impl/SkywellPathFind.h>
+#include <services/rpc/impl/LookupLedger.h>
+#include <services/rpc/Context.h>
+#include <transaction/paths/AccountCurrencies.h>
+#include <transaction/paths/Pathfinder.h>
+#include <common/json/json_reader.h>
+#include <protocol/ErrorCodes.h>
+#include <protocol/JsonFields.h>
+#include <services/net/RPCErr.h>
+#include <network/resource/Fees.h>
+#include <chrono>
+#include <fstream>
+
+namespace skywell {
+
+// Run one recorded skywell_path_find request against the replay ledger and
+// fill in its row of the stats table.
+static void replayPathFind (
+    Json::Value const& request,
+    Ledger::pointer const& ledger,
+    SkywellLineCache::pointer const& cache,
+    Json::Value& row)
+{
+    // Accept a request as logged by the RPC client as well as a bare one.
+    Json::Value const& params =
+        (request.isMember (jss::params) && request[jss::params].isArray ())
+            ? request[jss::params][0u]
+            : request;
+
+    SkywellAddress raSrc;
+    SkywellAddress raDst;
+    STAmount saDstAmount;
+
+    if (!params.isObject ())
+    {
+        row = rpcError (rpcINVALID_PARAMS);
+        return;
+    }
+
+    if (!params.isMember (jss::source_account))
+        row = rpcError (rpcSRC_ACT_MISSING);
+    else if (!params[jss::source_account].isString ()
+             || !raSrc.setAccountID (params[jss::source_account].asString ()))
+        row = rpcError (rpcSRC_ACT_MALFORMED);
+    else if (!params.isMember (jss::destination_account))
+        row = rpcError (rpcDST_ACT_MISSING);
+    else if (!params[jss::destination_account].isString ()
+             || !raDst.setAccountID (params[jss::destination_account].asString ()))
+        row = rpcError (rpcDST_ACT_MALFORMED);
+    else if (!params.isMember (jss::destination_amount)
+             || !amountFromJsonNoThrow (saDstAmount, params[jss::destination_amount])
+             || saDstAmount <= zero
+             || (!isSWT (saDstAmount.getCurrency ())
+                 && (!saDstAmount.getIssuer ()
+                     || noAccount () == saDstAmount.getIssuer ())))
+        row = rpcError (rpcINVALID_PARAMS);
+    else if (params.isMember (jss::source_currencies)
+             && (!params[jss::source_currencies].isArray ()
+                 || !params[jss::source_currencies].size ()))
+        row = rpcError (rpcINVALID_PARAMS);
+
+    if (row.isObject ())
+        return;
+
+    row[jss::source_account] = raSrc.humanAccountID ();
+    row[jss::destination_account] = raDst.humanAccountID ();
+
+    // The search depth is taken from the request or the configuration, never
+    // from the server's load, so that replays are repeatable.
+    int level = getConfig ().PATH_SEARCH_OLD;
+    if (params.isMember (jss::search_depth)
+        && params[jss::search_depth].isIntegral ())
+        level = params[jss::search_depth].asInt ();
+
+    auto contextPaths = params.isMember (jss::paths) ?
+        boost::optional<Json::Value> (params[jss::paths]) :
+            boost::optional<Json::Value> (boost::none);
+    bool const bidirectional = params.isMember (jss::search_mode)
+        && params[jss::search_mode].asString () == "bidirectional";
+
+    PathfinderStats stats;
+    auto const start = std::chrono::steady_clock::now ();
+
+    Json::Value jvSrcCurrencies = params.isMember (jss::source_currencies)
+        ? params[jss::source_currencies]
+        : buildSrcCurrencies (raSrc, cache);
+
+    auto result = skywellPathFind (cache, raSrc, raDst, saDstAmount,
+        ledger, jvSrcCurrencies, contextPaths, level, bidirectional, &stats);
+
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds> (
+        std::chrono::steady_clock::now () - start);
+
+    row[jss::latency_ms] = elapsed.count () / 1000.0;
+
+    if (!result.first)
+    {
+        for (auto const& name : result.second.getMemberNames ())
+            row[name] = result.second[name];
+        return;
+    }
+
+    row[jss::alternatives] = result.second.size ();
+    row[jss::paths_explored] = static_cast<Json::UInt> (stats.pathsExplored);
+    row[jss::liquidity_checks] = static_cast<Json::UInt> (stats.liquidityChecks);
+    row[jss::liquidity_cached] = static_cast<Json::UInt> (stats.liquidityCached);
+    row[jss::add_links_us] = static_cast<Json::UInt> (stats.addLinksTime.count ());
+    row[jss::liquidity_us] = static_cast<Json::UInt> (stats.liquidityTime.count ());
+}
+
+// Replay recorded path finding requests against one ledger and report the
+// time and pathfinder work each one took.
+//
+// {
+//   ledger_hash : <ledger>
+//   ledger_index : <ledger_index>
+//   file : <path to a JSON array of skywell_path_find requests>
+//   requests : [ <skywell_path_find request>, ... ]
+// }
+Json::Value doPathFindReplay (RPC::Context& context)
+{
+    context.loadType = Resource::feeHighBurdenRPC;
+
+    auto const hasFile = context.params.isMember (jss::file);
+    auto const hasRequests = context.params.isMember (jss::requests);
+
+    if (hasFile == hasRequests)
+    {
+        return RPC::make_param_error (
+            "Exactly one of file and requests can be set.");
+    }
+
+    Json::Value requests;
+
+    if (hasFile)
+    {
+        if (!context.params[jss::file].isString ())
+            return RPC::invalid_field_message (jss::file);
+
+        std::ifstream requestFile (
+            context.params[jss::file].asString ().c_str (), std::ios::in);
+        Json::Reader reader;
+
+        if (!requestFile || !reader.parse (requestFile, requests))
+            return RPC::invalid_field_message (jss::file);
+    }
+    else
+    {
+        requests = context.params[jss::requests];
+    }
+
+    if (!requests.isArray ())
+        return RPC::make_param_error ("Requests must be an array.");
+
+    Ledger::pointer ledger;
+    Json::Value jvResult = RPC::lookupLedger (
+        context.params, ledger, context.netOps);
+
+    if (!ledger)
+        return jvResult;
+
+    // Every request sees the same snapshot and a line cache of its own, so
+    // the replay neither disturbs nor benefits from live path requests.
+    ledger = std::make_shared<Ledger> (std::ref (*ledger), false);
+    auto const cache = std::make_shared<SkywellLineCache> (ledger);
+
+    Json::Value& rows = (jvResult[jss::requests] = Json::arrayValue);
+
+    for (Json::UInt i = 0; i != requests.size (); ++i)
+    {
+        Json::Value row;
+        replayPathFind (requests[i], ledger, cache, row);
+        row[jss::index] = i;
+        rows.append (row);
+
+        WriteLog (lsINFO, RPCHandler) << "path_find_replay " << i << ": "
+            << row[jss::latency_ms].asDouble () << "ms, "
+            << row[jss::paths_explored].asUInt () << " paths, "
+            << row[jss::liquidity_checks].asUInt () << " checks ("
+            << row[jss::liquidity_cached].asUInt () << " cached)";
+    }
+
+    return jvResult;
+}
+
+} // skywell
@@ -170,8 +170,11 @@ Json::Value doSkywellPathFind (RPC::Context& context)
         auto contextPaths = context.params.isMember(jss::paths) ?
             boost::optional<Json::Value>(context.params[jss::paths]) :
                 boost::optional<Json::Value>(boost::none);
+        bool const bidirectional = context.params.isMember(jss::search_mode)
+            && context.params[jss::search_mode].asString() == "bidirectional";
+
         auto pathFindResult = skywellPathFind(cache, raSrc, raDst, saDstAmount, 
-            lpLedger, jvSrcCurrencies, contextPaths, level);
+            lpLedger, jvSrcCurrencies, contextPaths, level, bidirectional);
         if (!pathFindResult.first)
             return pathFindResult.second;
 
@@ -207,7 +210,8 @@ skywellPathFind(SkywellLineCache::pointer const& cache,
   SkywellAddress const& raSrc, SkywellAddress const& raDst,
     STAmount const& saDstAmount, Ledger::pointer const& lpLedger, 
       Json::Value const& jvSrcCurrencies, 
-        boost::optional<Json::Value> const& contextPaths, int const& level)
+        boost::optional<Json::Value> const& contextPaths, int const& level,
+          bool bidirectional, PathfinderStats* stats)
 {
     FindPaths fp(
         cache,
@@ -215,7 +219,8 @@ skywellPathFind(SkywellLineCache::pointer const& cache,
         raDst.getAccountID(),
         saDstAmount,
         level,
-        4); // max paths
+        4, // max paths
+        bidirectional);
 
     Json::Value jvArray(Json::arrayValue);
 
@@ -362,6 +367,9 @@ skywellPathFind(SkywellLineCache::pointer const& cache,
         }
     }
 
+    if (stats)
+        fp.addStats(*stats);
+
     return std::make_pair(true, jvArray);
 }
 
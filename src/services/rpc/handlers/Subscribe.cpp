@@ -218,6 +218,8 @@ Json::Value doSubscribe (RPC::Context& context)
             bool bBoth =
                     (j.isMember (jss::both) && j[jss::both].asBool ()) ||
                     (j.isMember (jss::both_sides) && j[jss::both_sides].asBool ());
+            bool const bDelta =
+                    j.isMember (jss::delta) && j[jss::delta].asBool ();
             bool bSnapshot =
                     (j.isMember (jss::snapshot) && j[jss::snapshot].asBool ()) ||
                     (j.isMember (jss::state_now) && j[jss::state_now].asBool ());
@@ -294,10 +296,10 @@ Json::Value doSubscribe (RPC::Context& context)
                 return rpcError (rpcBAD_MARKET);
             }
 
-            context.netOps.subBook (ispSub, book);
+            context.netOps.subBook (ispSub, book, bDelta);
 
             if (bBoth)
-                context.netOps.subBook (ispSub, book);
+                context.netOps.subBook (ispSub, book, bDelta);
 
             if (bSnapshot)
             {
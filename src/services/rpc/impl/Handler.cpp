@@ -130,6 +130,7 @@ HandlerTable HANDLERS({
     {   "owner_info",           byRef (&doOwnerInfo),           Role::USER,  NEEDS_CURRENT_LEDGER  },
     {   "peers",                byRef (&doPeers),               Role::ADMIN,   NO_CONDITION     },
     {   "path_find",            byRef (&doPathFind),            Role::USER,  NEEDS_CURRENT_LEDGER  },
+    {   "path_find_replay",     byRef (&doPathFindReplay),      Role::ADMIN,   NO_CONDITION     },
     {   "ping",                 byRef (&doPing),                Role::USER,  NO_CONDITION     },
     {   "print",                byRef (&doPrint),               Role::ADMIN,   NO_CONDITION     },
 //      {   "profile",              byRef (&doProfile),             Role::USER,  NEEDS_CURRENT_LEDGER  },
@@ -149,6 +150,7 @@ HandlerTable HANDLERS({
     {   "transaction_entry",    byRef (&doTransactionEntry),    Role::USER,  NO_CONDITION  },
     {   "tx",                   byRef (&doTx),                  Role::USER,  NEEDS_NETWORK_CONNECTION  },
     {   "thread_info",          byRef (&doThreadInfo),          Role::USER,  NO_CONDITION     },
+    {   "traffic_info",         byRef (&doTrafficInfo),         Role::ADMIN,   NO_CONDITION     },
     {   "tx_history",           byRef (&doTxHistory),           Role::USER,  NO_CONDITION     },
     {   "unl_add",              byRef (&doUnlAdd),              Role::ADMIN,   NO_CONDITION     },
     {   "unl_delete",           byRef (&doUnlDelete),           Role::ADMIN,   NO_CONDITION     },
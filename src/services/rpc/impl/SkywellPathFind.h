@@ -26,13 +26,15 @@
 namespace skywell {
 
 class SkywellAddress;
+struct PathfinderStats;
 
 Json::Value
 buildSrcCurrencies(SkywellAddress const& raSrc, SkywellLineCache::pointer const& cache);
 
 std::pair<bool, Json::Value>
 skywellPathFind(SkywellLineCache::pointer const& cache, SkywellAddress const& raSrc, SkywellAddress const& raDst,
-    STAmount const& saDstAmount, Ledger::pointer const& lpLedger, Json::Value const& jvSrcCurrencies, boost::optional<Json::Value> const& contextPaths, int const& level);
+    STAmount const& saDstAmount, Ledger::pointer const& lpLedger, Json::Value const& jvSrcCurrencies, boost::optional<Json::Value> const& contextPaths, int const& level,
+    bool bidirectional = false, PathfinderStats* stats = nullptr);
 
 }
 
@@ -40,6 +40,7 @@ private:
     uint256 m_book;
     uint256 m_end;
     uint256 m_dir;
+    uint256 m_page;     // First page of the current quality directory
     uint256 m_index;
     SLE::pointer m_entry;
     Quality m_quality;
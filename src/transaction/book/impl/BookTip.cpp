@@ -49,7 +49,17 @@ BookTip::step ()
         // See if there's an entry at or worse than current quality. Notice
         // that the quality is encoded only in the index of the first page
         // of a directory.
-        auto const first_page (view ().getNextLedgerIndex (m_book, m_end));
+        //
+        // While the directory we were consuming still exists it is the
+        // next one in the book, so skip the search through the ledger.
+        uint256 first_page;
+
+        if (m_page.isNonZero () && view ().entryCache (ltDIR_NODE, m_page))
+            first_page = m_page;
+        else
+            first_page = view ().getNextLedgerIndex (m_book, m_end);
+
+        m_page.zero ();
 
         if (first_page.isZero ())
         {
@@ -65,6 +75,7 @@ BookTip::step ()
             m_entry = view ().entryCache (ltOFFER, m_index);
             m_quality = Quality (getQuality (first_page));
             m_valid = true;
+            m_page = first_page;
 
             // Next query should start before this directory
             m_book = first_page;
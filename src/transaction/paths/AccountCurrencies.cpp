@@ -24,7 +24,9 @@ namespace skywell {
 
 CurrencySet accountSourceCurrencies (SkywellAddress const& raAccountID, SkywellLineCache::ref lrCache, bool includeSWT)
 {
-    CurrencySet currencies;
+    // Lines with IOUs to send or credit left from the peer
+    CurrencySet currencies (
+        lrCache->getAccountCurrencies (raAccountID.getAccountID ())->send);
 
     // YYY Only bother if they are above reserve
     if (includeSWT)
@@ -32,71 +34,22 @@ CurrencySet accountSourceCurrencies (SkywellAddress const& raAccountID, SkywellL
         currencies.insert (xrpCurrency ());
     }
 
-    // List of skywell lines.
-    auto& skywellLines (lrCache->getSkywellLines (raAccountID.getAccountID ()));
-
-    for (auto const& item : skywellLines)
-    {
-        auto rspEntry = (SkywellState*) item.get ();
-
-        assert (rspEntry);
-
-        if (!rspEntry) 
-        {
-            continue;
-        }
-
-        auto& saBalance = rspEntry->getBalance ();
-
-        // Filter out non
-        if (saBalance > zero
-            // Have IOUs to send.
-            || (rspEntry->getLimitPeer ()
-                // Peer extends credit.
-                && ((-saBalance) < rspEntry->getLimitPeer ()))) // Credit left.
-        {
-            currencies.insert (saBalance.getCurrency ());
-        }
-    }
-
-    currencies.erase (badCurrency ());
-
     return currencies;
 }
 
 CurrencySet accountDestCurrencies (SkywellAddress const& raAccountID, SkywellLineCache::ref lrCache, bool includeSWT)
 {
-    CurrencySet currencies;
-
-    if (includeSWT)
-    {
-        currencies.insert (xrpCurrency ());
-    }
-
     // Even if account doesn't exist
 
-    // List of skywell lines.
-    auto& skywellLines (lrCache->getSkywellLines (raAccountID.getAccountID ()));
+    // Lines that can take more
+    CurrencySet currencies (
+        lrCache->getAccountCurrencies (raAccountID.getAccountID ())->receive);
 
-    for (auto const& item : skywellLines)
+    if (includeSWT)
     {
-        auto rspEntry = (SkywellState*) item.get ();
-        assert (rspEntry);
-
-        if (!rspEntry)
-        {
-            continue;
-        }
-
-        auto& saBalance  = rspEntry->getBalance ();
-        if (saBalance < rspEntry->getLimit ())                  // Can take more
-        {
-            currencies.insert (saBalance.getCurrency ());
-        }
+        currencies.insert (xrpCurrency ());
     }
 
-    currencies.erase (badCurrency());
-
     return currencies;
 }
 
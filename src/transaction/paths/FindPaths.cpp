@@ -31,13 +31,15 @@ public:
         Account const& dstAccount,
         STAmount const& dstAmount,
         int searchLevel,
-        unsigned int maxPaths)
+        unsigned int maxPaths,
+        bool bidirectional)
             : cache_ (cache),
               srcAccount_ (srcAccount),
               dstAccount_ (dstAccount),
               dstAmount_ (dstAmount),
               searchLevel_ (searchLevel),
-              maxPaths_ (maxPaths)
+              maxPaths_ (maxPaths),
+              bidirectional_ (bidirectional)
     {
     }
 
@@ -57,6 +59,15 @@ public:
         return false;
     }
 
+    void addStats (PathfinderStats& stats) const
+    {
+        for (auto const& entry : currencyMap_)
+        {
+            if (entry.second)
+                stats += entry.second->getStats ();
+        }
+    }
+
 private:
     hash_map<Currency, std::unique_ptr<Pathfinder>> currencyMap_;
 
@@ -66,6 +77,7 @@ private:
     STAmount const dstAmount_;
     int const searchLevel_;
     unsigned int const maxPaths_;
+    bool const bidirectional_;
 
     std::unique_ptr<Pathfinder> const& getPathFinder (Currency const& currency)
     {
@@ -74,6 +86,7 @@ private:
             return i->second;
         auto pathfinder = std::make_unique<Pathfinder> (
             cache_, srcAccount_, dstAccount_, currency, dstAmount_);
+        pathfinder->setBidirectional (bidirectional_);
         if (pathfinder->findPaths (searchLevel_))
             pathfinder->computePathRanks (maxPaths_);
         else
@@ -91,9 +104,11 @@ FindPaths::FindPaths (
     Account const& dstAccount,
     STAmount const& dstAmount,
     int level,
-    unsigned int maxPaths)
+    unsigned int maxPaths,
+    bool bidirectional)
         : impl_ (std::make_unique<Impl> (
-              cache, srcAccount, dstAccount, dstAmount, level, maxPaths))
+              cache, srcAccount, dstAccount, dstAmount, level, maxPaths,
+              bidirectional))
 {
 }
 
@@ -107,6 +122,11 @@ bool FindPaths::findPathsForIssue (
     return impl_->findPathsForIssue (issue, pathsInOut, fullLiquidityPath);
 }
 
+void FindPaths::addStats (PathfinderStats& stats) const
+{
+    impl_->addStats (stats);
+}
+
 bool findPathsForOneIssuer (
     SkywellLineCache::ref cache,
     Account const& srcAccount,
@@ -24,6 +24,8 @@
 
 namespace skywell {
 
+struct PathfinderStats;
+
 class FindPaths
 {
 public:
@@ -37,7 +39,10 @@ public:
         int searchLevel,
         /** maxPaths is the maximum number of paths that can be returned in
             pathsOut. */
-        unsigned int const maxPaths);
+        unsigned int const maxPaths,
+        /** Also search back from the destination, see
+            Pathfinder::setBidirectional. */
+        bool bidirectional = false);
 
     ~FindPaths();
 
@@ -57,6 +62,9 @@ public:
             path that can move the entire liquidity requested. */
         STPath& fullLiquidityPath);
 
+    /** Add the work done by each currency's pathfinder to stats. */
+    void addStats (PathfinderStats& stats) const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -50,6 +50,7 @@ PathRequest::PathRequest (
         , mInProgress (false)
         , iLastLevel (0)
         , bLastSuccess (false)
+        , bBidirectional (false)
         , iIdentifier (id)
 {
     if (m_journal.debug)
@@ -352,6 +353,11 @@ int PathRequest::parseJson (Json::Value const& jvParams, bool complete)
         }
     }
 
+    if (jvParams.isMember (jss::search_mode))
+    {
+        bBidirectional = jvParams[jss::search_mode].asString () == "bidirectional";
+    }
+
     if (jvParams.isMember ("id"))
     {
         jvId = jvParams["id"];
@@ -485,7 +491,8 @@ Json::Value PathRequest::doUpdate (SkywellLineCache::ref cache, bool fast)
         raDstAccount.getAccountID (),
         saDstAmount,
         iLevel,
-        4);  // iMaxPaths
+        4,  // iMaxPaths
+        bBidirectional);
 
     for (auto const& currIssuer: sourceCurrencies)
     {
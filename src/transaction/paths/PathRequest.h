@@ -113,6 +113,9 @@ private:
     int iLastLevel;
     bool bLastSuccess;
 
+    // Client asked for search_mode "bidirectional"
+    bool bBidirectional;
+
     int iIdentifier;
 
     boost::posix_time::ptime ptCreated;
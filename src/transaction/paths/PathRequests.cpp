@@ -24,6 +24,10 @@
 #include <common/core/JobQueue.h>
 #include <protocol/JsonFields.h>
 #include <network/resource/Fees.h>
+#include <transaction/paths/Tuning.h>
+#include <common/core/ParallelFor.h>
+#include <algorithm>
+#include <chrono>
 
 namespace skywell {
 
@@ -32,24 +36,97 @@ namespace skywell {
 */
 SkywellLineCache::pointer PathRequests::getLineCache (Ledger::pointer& ledger, bool authoritative)
 {
-    ScopedLockType sl (mLock);
-
-    std::uint32_t lineSeq = mLineCache ? mLineCache->getLedger()->getLedgerSeq() : 0;
+    SkywellLineCache::pointer previous;
+    std::uint32_t lineSeq;
     std::uint32_t lgrSeq = ledger->getLedgerSeq();
 
-    if ( (lineSeq == 0) ||                                 // no ledger
-         (authoritative && (lgrSeq > lineSeq)) ||          // newer authoritative ledger
-         (authoritative && ((lgrSeq + 8)  < lineSeq)) ||   // we jumped way back for some reason
-         (lgrSeq > (lineSeq + 8)))                         // we jumped way forward for some reason
     {
-        ledger = std::make_shared<Ledger>(*ledger, false); // Take a snapshot of the ledger
-        mLineCache = std::make_shared<SkywellLineCache> (ledger);
+        ScopedLockType sl (mLock);
+
+        lineSeq = mLineCache ? mLineCache->getLedger()->getLedgerSeq() : 0;
+
+        if ( (lineSeq != 0) &&                                 // have a ledger
+             !(authoritative && (lgrSeq > lineSeq)) &&         // not a newer authoritative ledger
+             !(authoritative && ((lgrSeq + 8)  < lineSeq)) &&  // didn't jump way back
+             !(lgrSeq > (lineSeq + 8)))                        // didn't jump way forward
+        {
+            ledger = mLineCache->getLedger();
+            return mLineCache;
+        }
+
+        previous = mLineCache;
     }
+
+    // Comparing against the previous cache walks both state maps, so the
+    // new cache is built without holding the lock
+    ledger = std::make_shared<Ledger>(*ledger, false); // Take a snapshot of the ledger
+
+    SkywellLineCache::pointer cache;
+
+    // Moving forward a few ledgers, keep the lines that did not change
+    if (lineSeq != 0 && lgrSeq > lineSeq && lgrSeq <= (lineSeq + 8))
+        cache = std::make_shared<SkywellLineCache> (ledger, *previous);
     else
+        cache = std::make_shared<SkywellLineCache> (ledger);
+
+    ScopedLockType sl (mLock);
+
+    // Another caller may have replaced the cache while we built ours
+    if (mLineCache == previous)
+        mLineCache = cache;
+
+    return cache;
+}
+
+SkywellLineCache::pointer PathRequests::peekLineCache (Ledger::ref ledger)
+{
+    ScopedLockType sl (mLock);
+
+    if (mLineCache &&
+        mLineCache->getLedger()->getLedgerSeq() == ledger->getLedgerSeq() &&
+        mLineCache->getLedger()->getHash() == ledger->getHash())
     {
-        ledger = mLineCache->getLedger();
+        return mLineCache;
     }
-    return mLineCache;
+
+    return SkywellLineCache::pointer ();
+}
+
+bool PathRequests::updateRequest (PathRequest::pointer const& pRequest,
+    SkywellLineCache::ref cache, bool newRequests, LedgerIndex ledgerSeq,
+        std::chrono::steady_clock::time_point passStart)
+{
+    if (!pRequest)
+        return false;
+
+    if (!pRequest->needsUpdate (newRequests, ledgerSeq))
+        return true;
+
+    InfoSub::pointer ipSub = pRequest->getSubscriber ();
+
+    if (!ipSub)
+        return false;
+
+    ipSub->getConsumer ().charge (Resource::feePathFindUpdate);
+
+    if (ipSub->getConsumer ().warn ())
+        return false;
+
+    auto const start = std::chrono::steady_clock::now ();
+
+    // How long this request waited in the pass before being serviced
+    mWait.notify (std::chrono::duration_cast<std::chrono::milliseconds> (
+        start - passStart));
+
+    Json::Value update = pRequest->doUpdate (cache, false);
+    pRequest->updateComplete ();
+    update[jss::type] = "path_find";
+    ipSub->send (update, false);
+
+    mUpdate.notify (std::chrono::duration_cast<std::chrono::milliseconds> (
+        std::chrono::steady_clock::now () - start));
+
+    return true;
 }
 
 void PathRequests::updateAll (Ledger::ref inLedger,
@@ -65,79 +142,73 @@ void PathRequests::updateAll (Ledger::ref inLedger,
     {
         ScopedLockType sl (mLock);
         requests = mRequests;
-        cache = getLineCache (ledger, true);
     }
 
+    cache = getLineCache (ledger, true);
+
     bool newRequests = getApp().getLedgerMaster().isNewPathRequest();
-    bool mustBreak = false;
+    std::atomic<bool> mustBreak (false);
 
     mJournal.trace << "updateAll seq=" << ledger->getLedgerSeq() << ", " <<
         requests.size() << " requests";
-    int processed = 0, removed = 0;
+    std::atomic<int> processed (0);
+    int removed = 0;
 
     do
     {
-        for (auto& wRequest : requests)
-        {
-            if (shouldCancel())
-                break;
-
-            bool remove = true;
-            PathRequest::pointer pRequest = wRequest.lock ();
-
-            if (pRequest)
+        // Requests are handed out in order, so the oldest unserviced
+        // requests start first, and every worker shares the line cache
+        std::vector<char> keep (requests.size (), 1);
+        auto const passStart = std::chrono::steady_clock::now ();
+        LedgerIndex const ledgerSeq = ledger->getLedgerSeq ();
+
+        parallelFor (getApp().getJobQueue (), jtUPDATE_PF, "PathRequests::update",
+            requests.size (), PATHFINDER_UPDATES_PER_JOB,
+                PATHFINDER_UPDATE_JOBS_MAX,
+            [&] (std::size_t i)
             {
-                if (!pRequest->needsUpdate (newRequests, ledger->getLedgerSeq ()))
-                    remove = false;
+                if (mustBreak || shouldCancel ())
+                    return;
+
+                if (!updateRequest (requests[i].lock (), cache,
+                        newRequests, ledgerSeq, passStart))
+                    keep[i] = 0;
                 else
-                {
-                    InfoSub::pointer ipSub = pRequest->getSubscriber ();
-                    if (ipSub)
-                    {
-                        ipSub->getConsumer ().charge (Resource::feePathFindUpdate);
-                        if (!ipSub->getConsumer ().warn ())
-                        {
-                            Json::Value update = pRequest->doUpdate (cache, false);
-                            pRequest->updateComplete ();
-                            update[jss::type] = "path_find";
-                            ipSub->send (update, false);
-                            remove = false;
-                            ++processed;
-                        }
-                    }
-                }
-            }
+                    ++processed;
 
-            if (remove)
-            {
-                PathRequest::pointer pRequest = wRequest.lock ();
+                // We weren't handling new requests and then there was a new request
+                if (!newRequests && getApp().getLedgerMaster().isNewPathRequest())
+                    mustBreak = true;
+            });
+
+        for (std::size_t i = 0; i < requests.size (); ++i)
+        {
+            if (keep[i])
+                continue;
+
+            PathRequest::pointer pRequest = requests[i].lock ();
 
-                ScopedLockType sl (mLock);
+            ScopedLockType sl (mLock);
 
-                // Remove any dangling weak pointers or weak pointers that refer to this path request.
-                std::vector<PathRequest::wptr>::iterator it = mRequests.begin();
-                while (it != mRequests.end())
+            // Remove any dangling weak pointers or weak pointers that refer to this path request.
+            std::vector<PathRequest::wptr>::iterator it = mRequests.begin();
+            while (it != mRequests.end())
+            {
+                PathRequest::pointer itRequest = it->lock ();
+                if (!itRequest || (itRequest == pRequest))
                 {
-                    PathRequest::pointer itRequest = it->lock ();
-                    if (!itRequest || (itRequest == pRequest))
-                    {
-                        ++removed;
-                        it = mRequests.erase (it);
-                    }
-                    else
-                        ++it;
+                    ++removed;
+                    it = mRequests.erase (it);
                 }
+                else
+                    ++it;
             }
-
-            mustBreak = !newRequests && getApp().getLedgerMaster().isNewPathRequest();
-            if (mustBreak) // We weren't handling new requests and then there was a new request
-                break;
-
         }
 
         if (mustBreak)
         { // a new request came in while we were working
             newRequests = true;
+            mustBreak = false;
         }
         else if (newRequests)
         { // we only did new requests, so we always need a last pass
@@ -147,7 +218,7 @@ void PathRequests::updateAll (Ledger::ref inLedger,
         { // check if there are any new requests, otherwise we are done
             newRequests = getApp().getLedgerMaster().isNewPathRequest();
             if (!newRequests) // We did a full pass and there are no new requests
-                return;
+                break;
         }
 
         {
@@ -157,10 +228,10 @@ void PathRequests::updateAll (Ledger::ref inLedger,
             if (mRequests.empty())
                 break;
             requests = mRequests;
-
-            cache = getLineCache (ledger, false);
         }
 
+        cache = getLineCache (ledger, false);
+
     }
     while (!shouldCancel ());
 
@@ -177,12 +248,7 @@ Json::Value PathRequests::makePathRequest(
         subscriber, ++mLastIdentifier, *this, mJournal);
 
     Ledger::pointer ledger = inLedger;
-    SkywellLineCache::pointer cache;
-
-    {
-        ScopedLockType sl (mLock);
-        cache = getLineCache (ledger, false);
-    }
+    SkywellLineCache::pointer cache = getLineCache (ledger, false);
 
     bool valid = false;
     Json::Value result = req->doCreate (ledger, cache, requestJson, valid);
@@ -24,6 +24,7 @@
 #include <transaction/paths/SkywellLineCache.h>
 #include <common/core/Job.h>
 #include <atomic>
+#include <chrono>
 
 namespace skywell {
 
@@ -36,6 +37,8 @@ public:
     {
         mFast = collector->make_event ("pathfind_fast");
         mFull = collector->make_event ("pathfind_full");
+        mUpdate = collector->make_event ("pathfind_update");
+        mWait = collector->make_event ("pathfind_wait");
     }
 
     void updateAll (const std::shared_ptr<Ledger>& ledger,
@@ -44,6 +47,11 @@ public:
     SkywellLineCache::pointer getLineCache (
         Ledger::pointer& ledger, bool authoritative);
 
+    /** Return the shared line cache if it was built for this ledger.
+        Unlike getLineCache, this never builds or installs a cache.
+    */
+    SkywellLineCache::pointer peekLineCache (Ledger::ref ledger);
+
     Json::Value makePathRequest (
         std::shared_ptr <InfoSub> const& subscriber,
         const std::shared_ptr<Ledger>& ledger,
@@ -60,11 +68,22 @@ public:
     }
 
 private:
+    // Update one request, returns false if it should be removed
+    bool updateRequest (PathRequest::pointer const& pRequest,
+        SkywellLineCache::ref cache, bool newRequests,
+            LedgerIndex ledgerSeq,
+                std::chrono::steady_clock::time_point passStart);
+
     beast::Journal                   mJournal;
 
     beast::insight::Event            mFast;
     beast::insight::Event            mFull;
 
+    // How long each request's update took, and how long it waited in
+    // its pass before the update started
+    beast::insight::Event            mUpdate;
+    beast::insight::Event            mWait;
+
     // Track all requests
     std::vector<PathRequest::wptr>   mRequests;
 
@@ -418,7 +418,7 @@ TER PathState::pushNode (
 // terStatus = tesSUCCESS, temBAD_PATH, terNO_LINE, terNO_ACCOUNT, terNO_AUTH,
 // or temBAD_PATH_LOOP
 TER PathState::expandPath (
-    const LedgerEntrySet& lesSource,
+    LedgerEntrySet& lesSource,
     STPath const& spSourcePath,
     Account const& uReceiverID,
     Account const& uSenderID)
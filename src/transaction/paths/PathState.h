@@ -46,8 +46,9 @@ class PathState : public CountedObject <PathState>
 
     void reset(STAmount const& in, STAmount const& out);
 
+    // The source set is duplicated, which shares its entries with the path
     TER expandPath (
-        LedgerEntrySet const&   lesSource,
+        LedgerEntrySet&         lesSource,
         STPath const&           spSourcePath,
         Account const&          uReceiverID,
         Account const&          uSenderID
@@ -209,6 +209,10 @@ Pathfinder::Pathfinder (
 
 Pathfinder::~Pathfinder()
 {
+    WriteLog (lsDEBUG, Pathfinder) << "Explored " << mStats.pathsExplored
+        << " paths in " << mStats.addLinksTime.count () << "us, checked "
+        << mStats.liquidityChecks << " paths (" << mStats.liquidityCached
+        << " cached) in " << mStats.liquidityTime.count () << "us";
 }
 
 bool Pathfinder::findPaths (int searchLevel)
@@ -347,6 +351,9 @@ bool Pathfinder::findPaths (int searchLevel)
         paymentType = pt_nonSWT_to_nonSWT;
     }
 
+    if (mBidirectional && !bDstXrp)
+        buildDestinationFrontier ();
+
     // Now iterate over all paths for that paymentType.
     for (auto const& costedPath : mPathTable[paymentType])
     {
@@ -375,6 +382,57 @@ TER Pathfinder::getPathLiquidity (
                                    //      deliver to be worth keeping.
     STAmount& amountOut,           // OUT: The actual liquidity along the path.
     uint64_t& qualityOut) const    // OUT: The returned initial quality
+{
+    // The same path is often ranked by several requests against one
+    // ledger, so results are remembered in the ledger's line cache.
+    Serializer s;
+    s.add160 (mSrcAccount);
+    s.add160 (mDstAccount);
+    mSrcAmount.add (s);
+    mDstAmount.add (s);
+    minDstAmount.add (s);
+
+    for (auto const& node : path)
+    {
+        s.add32 (node.getNodeType ());
+        s.add160 (node.getAccountID ());
+        s.add160 (node.getCurrency ());
+        s.add160 (node.getIssuerID ());
+    }
+
+    uint256 const key = s.getSHA512Half ();
+    SkywellLineCache::PathLiquidity cached;
+
+    ++mStats.liquidityChecks;
+
+    if (mRLCache->getPathLiquidity (key, cached))
+    {
+        ++mStats.liquidityCached;
+        amountOut = cached.amount;
+        qualityOut = cached.quality;
+        return cached.result;
+    }
+
+    auto const start = std::chrono::steady_clock::now ();
+
+    TER const result = computePathLiquidity (
+        path, minDstAmount, amountOut, qualityOut);
+
+    mStats.liquidityTime += std::chrono::duration_cast<std::chrono::microseconds> (
+        std::chrono::steady_clock::now () - start);
+
+    if (result != tefEXCEPTION)
+        mRLCache->setPathLiquidity (key, {result, amountOut,
+            result == tesSUCCESS ? qualityOut : 0});
+
+    return result;
+}
+
+TER Pathfinder::computePathLiquidity (
+    STPath const& path,
+    STAmount const& minDstAmount,
+    STAmount& amountOut,
+    uint64_t& qualityOut) const
 {
     STPathSet pathSet;
     pathSet.push_back (path);
@@ -725,7 +783,7 @@ int Pathfinder::getPathsOut (Currency const& currency
     {
         count = getApp ().getOrderBookDB ().getBookSize (issue);
 
-        for (auto const& item : mRLCache->getSkywellLines (account))
+        for (auto const& item : mRLCache->getSkywellLines (account, currency))
         {
             SkywellState* rspEntry = (SkywellState*) item.get ();
 
@@ -763,6 +821,31 @@ int Pathfinder::getPathsOut (Currency const& currency
     return count;
 }
 
+void Pathfinder::buildDestinationFrontier ()
+{
+    mDstFrontier.clear ();
+
+    auto const& lines = mRLCache->getSkywellLines (
+        mEffectiveDst, mDstAmount.getCurrency ());
+
+    for (auto const& line : lines)
+    {
+        auto const& peer = line->getAccountIDPeer ();
+
+        if (peer == mSrcAccount || peer == mDstAccount)
+            continue;
+
+        // The destination must be willing to hold more from this peer
+        if (line->getFreeze () || line->getBalance () >= line->getLimit ())
+            continue;
+
+        mDstFrontier.insert (peer);
+    }
+
+    WriteLog (lsDEBUG, Pathfinder) << mDstFrontier.size ()
+        << " accounts pay the destination directly";
+}
+
 void Pathfinder::addLinks (
     STPathSet const& currentPaths,  // The paths to build from
     STPathSet& incompletePaths,     // The set of partial paths we add to
@@ -772,10 +855,17 @@ void Pathfinder::addLinks (
         << "addLink< on " << currentPaths.size ()
         << " source(s), flags=" << addFlags;
 
+    auto const start = std::chrono::steady_clock::now ();
+    auto const before = incompletePaths.size ();
+
     for (auto const& path: currentPaths)
     {
         addLink (path, incompletePaths, addFlags);
     }
+
+    mStats.pathsExplored += incompletePaths.size () - before;
+    mStats.addLinksTime += std::chrono::duration_cast<std::chrono::microseconds> (
+        std::chrono::steady_clock::now () - start);
 }
 
 STPathSet& Pathfinder::addPathsForType (PathType const& pathType)
@@ -946,7 +1036,8 @@ void Pathfinder::addLink (
                 bool const bDestOnly (
                     addFlags & afAC_LAST);
 
-                auto& skywellLines (mRLCache->getSkywellLines (uEndAccount));
+                auto& skywellLines (
+                    mRLCache->getSkywellLines (uEndAccount, uEndCurrency));
 
                 AccountCandidates candidates;
                 candidates.reserve (skywellLines.size ());
@@ -969,8 +1060,10 @@ void Pathfinder::addLink (
                     }
 
                     bool bToDestination = acct == mEffectiveDst;
+                    bool const bMeetsDestination = bIsEndCurrency &&
+                        mDstFrontier.count (acct) != 0;
 
-                    if (bDestOnly && !bToDestination)
+                    if (bDestOnly && !bToDestination && !bMeetsDestination)
                     {
                         continue;
                     }
@@ -1016,6 +1109,25 @@ void Pathfinder::addLink (
                         {
                             // going back to the source is bad
                         }
+                        else if (bMeetsDestination)
+                        {
+                            // this account pays the destination directly
+                            STPath newPath (currentPath);
+                            newPath.emplace_back (
+                                STPathElement::typeAccount,
+                                acct,
+                                uEndCurrency,
+                                acct);
+
+                            WriteLog (lsTRACE, Pathfinder)
+                                    << "complete path found af: "
+                                    << newPath.getJson (0);
+                            addUniquePath (mCompletePaths, newPath);
+
+                            if (!bDestOnly)
+                                candidates.push_back (
+                                    {AccountCandidate::highPriority, acct});
+                        }
                         else
                         {
                             // save this candidate
@@ -25,9 +25,34 @@
 #include <common/core/LoadEvent.h>
 #include <protocol/STAmount.h>
 #include <protocol/STPathSet.h>
+#include <chrono>
 
 namespace skywell {
 
+/** Work done by a pathfinder.
+
+    Logged at debug level when the pathfinder is destroyed, and reported
+    per request by the path_find_replay admin command.
+*/
+struct PathfinderStats
+{
+    std::size_t pathsExplored = 0;
+    std::size_t liquidityChecks = 0;
+    std::size_t liquidityCached = 0;
+    std::chrono::microseconds addLinksTime {0};
+    std::chrono::microseconds liquidityTime {0};
+
+    PathfinderStats& operator+= (PathfinderStats const& other)
+    {
+        pathsExplored += other.pathsExplored;
+        liquidityChecks += other.liquidityChecks;
+        liquidityCached += other.liquidityCached;
+        addLinksTime += other.addLinksTime;
+        liquidityTime += other.liquidityTime;
+        return *this;
+    }
+};
+
 /** Calculates payment paths.
 
     The @ref SkywellCalc determines the quality of the found paths.
@@ -58,8 +83,25 @@ public:
 
     static void initPathTable ();
 
+    /** Also search back from the destination.
+
+        Accounts that can deliver the destination currency straight to the
+        destination are found first, and a forward path that reaches one of
+        them is complete one step early. The liquidity checks made when
+        ranking discard any that can't carry funds.
+    */
+    void setBidirectional (bool bidirectional)
+    {
+        mBidirectional = bidirectional;
+    }
+
     bool findPaths (int searchLevel);
 
+    PathfinderStats const& getStats () const
+    {
+        return mStats;
+    }
+
     /** Compute the rankings of the paths. */
     void computePathRanks (int maxPaths);
 
@@ -122,7 +164,8 @@ private:
       computePathRanks:
           skywellCalculate
           getPathLiquidity:
-              skywellCalculate
+              computePathLiquidity:
+                  skywellCalculate
 
       getBestPaths
      */
@@ -159,10 +202,21 @@ private:
         STAmount& amountOut,           // OUT: The actual liquidity on the path.
         uint64_t& qualityOut) const;   // OUT: The returned initial quality
 
+    // getPathLiquidity without consulting the line cache's results.
+    TER computePathLiquidity (
+        STPath const& path,
+        STAmount const& minDstAmount,
+        STAmount& amountOut,
+        uint64_t& qualityOut) const;
+
     // Does this path end on an account-to-account link whose last account has
     // set the "no skywell" flag on the link?
     bool isNoSkywellOut (STPath const& currentPath);
 
+    // Find the accounts that can pay the destination currency directly to
+    // the effective destination.
+    void buildDestinationFrontier ();
+
     // Is the "no skywell" flag set from one account to another?
     bool isNoSkywell (
         Account const& fromAccount,
@@ -196,6 +250,11 @@ private:
 
     hash_map<Issue, int> mPathsOutCountMap;
 
+    bool mBidirectional = false;
+    hash_set<Account> mDstFrontier;
+
+    mutable PathfinderStats mStats;
+
     // Add skywell paths
     static std::uint32_t const afADD_ACCOUNTS = 0x001;
 
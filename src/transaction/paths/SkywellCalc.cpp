@@ -206,7 +206,9 @@ TER SkywellCalc::skywellCalculate ()
     while (resultCode == temUNCERTAIN)
     {
         int iBest = -1;
-        LedgerEntrySet lesCheckpoint = mActiveLedger;
+        // Freezing the active ledger lets every path's trial ledger share
+        // the checkpoint's entries instead of copying them
+        LedgerEntrySet lesCheckpoint = mActiveLedger.duplicate ();
         int iDry = 0;
 
         // True, if ever computed multi-quality.
@@ -19,6 +19,8 @@
 
 #include <BeastConfig.h>
 #include <transaction/paths/SkywellLineCache.h>
+#include <transaction/paths/Tuning.h>
+#include <common/shamap/SHAMapMissingNode.h>
 
 namespace skywell {
 
@@ -27,6 +29,96 @@ SkywellLineCache::SkywellLineCache (Ledger::ref l)
 {
 }
 
+SkywellLineCache::SkywellLineCache (Ledger::ref l, SkywellLineCache& previous)
+    : hasher_ (previous.hasher_)
+    , mLedger (l)
+{
+    hash_set<Account> used;
+
+    {
+        ScopedLockType sl (previous.mLock);
+
+        if (previous.mUsed.size () > PATHFINDER_LINE_CACHE_MAX_USED)
+            return;
+
+        used = previous.mUsed;
+    }
+
+    hash_set<Account> changed;
+
+    if (!getChangedAccounts (previous.getLedger (), l, changed))
+        return;
+
+    auto keep = [&used, &changed] (Account const& account)
+    {
+        return (used.count (account) != 0) && (changed.count (account) == 0);
+    };
+
+    ScopedLockType sl (previous.mLock);
+
+    for (auto const& entry : previous.mRLMap)
+    {
+        if (keep (entry.first.account_))
+            mRLMap.emplace (entry.first, entry.second);
+    }
+
+    for (auto const& entry : previous.mCurrencies)
+    {
+        if (keep (entry.first.account_))
+            mCurrencies.emplace (entry.first, entry.second);
+    }
+
+    WriteLog (lsTRACE, Pathfinder) << "Line cache for " << l->getLedgerSeq ()
+        << " kept " << mRLMap.size () << " of " << previous.mRLMap.size ()
+        << " entries, " << changed.size () << " accounts changed";
+
+    WriteLog (lsDEBUG, Pathfinder) << "Line cache for "
+        << previous.getLedger ()->getLedgerSeq () << " currency sets: "
+        << previous.mCurrencyHits << " hits, "
+        << previous.mCurrencyMisses << " misses, "
+        << mCurrencies.size () << " kept";
+}
+
+bool
+SkywellLineCache::getChangedAccounts (Ledger::ref from, Ledger::ref to,
+    hash_set<Account>& accounts)
+{
+    SHAMap::Delta differences;
+
+    try
+    {
+        if (!from->peekAccountStateMap ()->compare (
+                to->peekAccountStateMap (), differences,
+                    PATHFINDER_LINE_CACHE_MAX_DELTA))
+            return false;
+    }
+    catch (SHAMapMissingNode const& mn)
+    {
+        // Either ledger may still be missing nodes, start from scratch
+        WriteLog (lsDEBUG, Pathfinder) << "Line cache carry forward: " << mn;
+        return false;
+    }
+
+    for (auto& diff : differences)
+    {
+        for (auto const& item : { diff.second.first, diff.second.second })
+        {
+            if (!item)
+                continue;
+
+            STLedgerEntry sle (item->peekSerializer (), item->getTag ());
+
+            if (sle.getType () == ltSKYWELL_STATE)
+            {
+                accounts.insert (sle.getFieldAmount (sfLowLimit).getIssuer ());
+                accounts.insert (sle.getFieldAmount (sfHighLimit).getIssuer ());
+            }
+        }
+    }
+
+    return true;
+}
+
 SkywellLineCache::SkywellStateVector const&
 SkywellLineCache::getSkywellLines (Account const& accountID)
 {
@@ -34,14 +126,133 @@ SkywellLineCache::getSkywellLines (Account const& accountID)
 
     ScopedLockType sl (mLock);
 
-    auto it = mRLMap.emplace (key, SkywellStateVector ());
+    mUsed.insert (accountID);
+
+    auto it = mRLMap.emplace (key, SharedVector ());
 
     if (it.second)
     {
-        it.first->second = skywell::getSkywellStateItems (accountID, mLedger);
+        it.first->second = std::make_shared<SkywellStateVector> (
+            skywell::getSkywellStateItems (accountID, mLedger));
+    }
+
+    return *it.first->second;
+}
+
+SkywellLineCache::SkywellStateVector const&
+SkywellLineCache::getSkywellLines (Account const& accountID,
+    Currency const& currency)
+{
+    AccountKey key (accountID, currency, hasher_ (accountID) ^ hasher_ (currency));
+
+    {
+        ScopedLockType sl (mLock);
+
+        auto it = mRLMap.find (key);
+
+        if (it != mRLMap.end ())
+        {
+            mUsed.insert (accountID);
+            return *it->second;
+        }
+    }
+
+    auto lines = std::make_shared<SkywellStateVector> ();
+
+    for (auto const& line : getSkywellLines (accountID))
+    {
+        if (line->getLimit ().getCurrency () == currency)
+            lines->push_back (line);
+    }
+
+    ScopedLockType sl (mLock);
+
+    return *mRLMap.emplace (key, lines).first->second;
+}
+
+std::shared_ptr <SkywellLineCache::AccountCurrencies const>
+SkywellLineCache::getAccountCurrencies (Account const& accountID)
+{
+    AccountKey key (accountID, hasher_ (accountID));
+
+    {
+        ScopedLockType sl (mLock);
+
+        auto it = mCurrencies.find (key);
+
+        if (it != mCurrencies.end ())
+        {
+            mUsed.insert (accountID);
+            ++mCurrencyHits;
+            return it->second;
+        }
+
+        ++mCurrencyMisses;
+    }
+
+    auto currencies = std::make_shared<AccountCurrencies> ();
+
+    for (auto const& line : getSkywellLines (accountID))
+    {
+        auto const& saBalance = line->getBalance ();
+
+        // Can take more
+        if (saBalance < line->getLimit ())
+            currencies->receive.insert (saBalance.getCurrency ());
+
+        // Has IOUs to send, or the peer extends credit that is left
+        if ((-saBalance) < line->getLimitPeer ())
+            currencies->send.insert (saBalance.getCurrency ());
     }
 
-    return it.first->second;
+    currencies->send.erase (badCurrency ());
+    currencies->receive.erase (badCurrency ());
+
+    ScopedLockType sl (mLock);
+
+    return mCurrencies.emplace (key, currencies).first->second;
+}
+
+std::shared_ptr <SkywellLineCache::AccountCurrencies const>
+SkywellLineCache::findAccountCurrencies (Account const& accountID)
+{
+    AccountKey key (accountID, hasher_ (accountID));
+
+    ScopedLockType sl (mLock);
+
+    auto it = mCurrencies.find (key);
+
+    if (it == mCurrencies.end ())
+        return nullptr;
+
+    return it->second;
+}
+
+bool
+SkywellLineCache::getPathLiquidity (uint256 const& key,
+    PathLiquidity& liquidity)
+{
+    ScopedLockType sl (mLiquidityLock);
+
+    auto it = mLiquidity.find (key);
+
+    if (it == mLiquidity.end ())
+        return false;
+
+    liquidity = it->second;
+    return true;
+}
+
+void
+SkywellLineCache::setPathLiquidity (uint256 const& key,
+    PathLiquidity const& liquidity)
+{
+    ScopedLockType sl (mLiquidityLock);
+
+    if (mLiquidity.size () >= PATHFINDER_LIQUIDITY_CACHE_MAX)
+        mLiquidity.clear ();
+
+    mLiquidity[key] = liquidity;
 }
 
 } // skywell
@@ -22,6 +22,7 @@
 
 #include <transaction/paths/SkywellState.h>
 #include <common/base/hardened_hash.h>
+#include <protocol/TER.h>
 #include <cstddef>
 #include <memory>
 #include <vector>
@@ -29,6 +30,15 @@
 namespace skywell {
 
 // Used by Pathfinder
+//
+// Lines are indexed by account and, on request, by account and currency.
+// A cache built from a previous one carries forward every account that
+// was looked up in the previous one and whose trust lines did not change
+// between the two ledgers, along with the currencies it can send and
+// receive. Accounts nobody asks about drop out after one ledger.
+//
+// It also remembers the liquidity found along candidate paths, which only
+// holds for this ledger and so is never carried forward.
 class SkywellLineCache
 {
 public:
@@ -38,6 +48,8 @@ public:
 
     explicit SkywellLineCache (Ledger::ref l);
 
+    SkywellLineCache (Ledger::ref l, SkywellLineCache& previous);
+
     Ledger::ref getLedger () //  TODO const?
     {
         return mLedger;
@@ -46,7 +58,46 @@ public:
     std::vector<SkywellState::pointer> const&
     getSkywellLines (Account const& accountID);
 
+    // Only the lines of the account that are in the given currency
+    std::vector<SkywellState::pointer> const&
+    getSkywellLines (Account const& accountID, Currency const& currency);
+
+    // The currencies an account can send and receive through its lines,
+    // not counting SWT
+    struct AccountCurrencies
+    {
+        CurrencySet send;
+        CurrencySet receive;
+    };
+
+    std::shared_ptr <AccountCurrencies const>
+    getAccountCurrencies (Account const& accountID);
+
+    // The cached currencies of the account, or null. Unlike
+    // getAccountCurrencies, this never adds to the cache.
+    std::shared_ptr <AccountCurrencies const>
+    findAccountCurrencies (Account const& accountID);
+
+    struct PathLiquidity
+    {
+        TER result;
+        STAmount amount;
+        std::uint64_t quality;
+    };
+
+    bool getPathLiquidity (uint256 const& key, PathLiquidity& liquidity);
+
+    void setPathLiquidity (uint256 const& key, PathLiquidity const& liquidity);
+
 private:
+    typedef std::shared_ptr <SkywellStateVector const> SharedVector;
+
+    // Accounts whose trust lines differ between the two ledgers, returns
+    // false if the ledgers are too different to be worth comparing or
+    // either one is missing nodes
+    static bool getChangedAccounts (Ledger::ref from, Ledger::ref to,
+        hash_set<Account>& accounts);
+
     typedef SkywellMutex LockType;
     typedef std::lock_guard <LockType> ScopedLockType;
     LockType mLock;
@@ -57,6 +108,7 @@ private:
     struct AccountKey
     {
         Account account_;
+        Currency currency_;
         std::size_t hash_value_;
 
         AccountKey (Account const& account, std::size_t hash)
@@ -64,6 +116,13 @@ private:
             , hash_value_ (hash)
         { }
 
+        AccountKey (Account const& account, Currency const& currency,
+                std::size_t hash)
+            : account_ (account)
+            , currency_ (currency)
+            , hash_value_ (hash)
+        { }
+
         AccountKey (AccountKey const& other) = default;
 
         AccountKey&
@@ -71,7 +130,8 @@ private:
 
         bool operator== (AccountKey const& lhs) const
         {
-            return hash_value_ == lhs.hash_value_ && account_ == lhs.account_;
+            return hash_value_ == lhs.hash_value_ &&
+                account_ == lhs.account_ && currency_ == lhs.currency_;
         }
 
         std::size_t
@@ -90,7 +150,19 @@ private:
         };
     };
 
-    hash_map <AccountKey, SkywellStateVector, AccountKey::Hash> mRLMap;
+    // Entries with a zero currency hold all of an account's lines
+    hash_map <AccountKey, SharedVector, AccountKey::Hash> mRLMap;
+
+    // Accounts looked up in this cache, the only ones carried forward
+    hash_set <Account> mUsed;
+
+    hash_map <AccountKey, std::shared_ptr <AccountCurrencies const>,
+        AccountKey::Hash> mCurrencies;
+    std::uint64_t mCurrencyHits = 0;
+    std::uint64_t mCurrencyMisses = 0;
+
+    LockType mLiquidityLock;
+    hash_map <uint256, PathLiquidity> mLiquidity;
 };
 
 } // skywell
@@ -29,6 +29,18 @@ int const PATHFINDER_HIGH_PRIORITY          = 100000;
 int const PATHFINDER_MAX_PATHS              = 50;
 int const PATHFINDER_MAX_COMPLETE_PATHS     = 1000;
 int const PATHFINDER_MAX_PATHS_FROM_SOURCE  = 10;
+int const PATHFINDER_UPDATE_JOBS_MAX        = 4;
+int const PATHFINDER_UPDATES_PER_JOB        = 2;
+
+// Ledgers further apart than this rebuild the trust line cache from scratch
+int const PATHFINDER_LINE_CACHE_MAX_DELTA   = 4096;
+
+// A trust line cache that served more accounts than this in its ledger is
+// not carried forward
+int const PATHFINDER_LINE_CACHE_MAX_USED    = 16384;
+
+// Path liquidity results remembered for one ledger
+int const PATHFINDER_LIQUIDITY_CACHE_MAX    = 16384;
 
 } // skywell
 
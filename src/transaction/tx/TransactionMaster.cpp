@@ -28,6 +28,8 @@ namespace skywell {
 TransactionMaster::TransactionMaster ()
     : mCache ("TransactionCache", 65536, 1800, get_seconds_clock (),
         deprecatedLogs().journal("TaggedCache"))
+    , mParsed ("ParsedTransactionCache", 65536, 300, get_seconds_clock (),
+        deprecatedLogs().journal("TaggedCache"))
 {
 }
 
@@ -59,6 +61,33 @@ Transaction::pointer TransactionMaster::fetch (uint256 const& txnID, bool checkD
     return txn;
 }
 
+STTx::pointer TransactionMaster::parse (uint256 const& txID, SerialIter& sit)
+{
+    STTx::pointer txn = mParsed.fetch (txID);
+
+    if (txn)
+        return txn;
+
+    Transaction::pointer iTx = mCache.fetch (txID);
+
+    if (iTx)
+    {
+        txn = iTx->getSTransaction ();
+    }
+    else
+    {
+        txn = std::make_shared<STTx> (std::ref (sit));
+
+        // Only share it if this was its canonical serialization
+        if (txn->getTransactionID () != txID)
+            return txn;
+    }
+
+    mParsed.canonicalize (txID, txn);
+
+    return txn;
+}
+
 STTx::pointer TransactionMaster::fetch (std::shared_ptr<SHAMapItem> const& item,
         SHAMapTreeNode::TNType type,
         bool checkDisk, std::uint32_t uCommitLedger)
@@ -72,7 +101,7 @@ STTx::pointer TransactionMaster::fetch (std::shared_ptr<SHAMapItem> const& item,
         if (type == SHAMapTreeNode::tnTRANSACTION_NM)
         {
             SerialIter sit (item->peekSerializer ());
-            txn = std::make_shared<STTx> (std::ref (sit));
+            txn = parse (item->getTag (), sit);
         }
         else if (type == SHAMapTreeNode::tnTRANSACTION_MD)
         {
@@ -81,7 +110,7 @@ STTx::pointer TransactionMaster::fetch (std::shared_ptr<SHAMapItem> const& item,
             item->peekSerializer ().getVL (s.modData (), 0, length);
             SerialIter sit (s);
 
-            txn = std::make_shared<STTx> (std::ref (sit));
+            txn = parse (item->getTag (), sit);
         }
     }
     else
@@ -119,6 +148,7 @@ bool TransactionMaster::canonicalize (Transaction::pointer* pTransaction)
 void TransactionMaster::sweep (void)
 {
     mCache.sweep ();
+    mParsed.sweep ();
 }
 
 TaggedCache <uint256, Transaction>& TransactionMaster::getCache()
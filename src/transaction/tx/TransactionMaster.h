@@ -37,6 +37,16 @@ public:
     STTx::pointer  fetch (std::shared_ptr<SHAMapItem> const& item, SHAMapTreeNode:: TNType type,
                                            bool checkDisk, std::uint32_t uCommitLedger);
 
+    /** Returns the transaction parsed from its serialization.
+
+        Parsed transactions are shared through a cache keyed by ID, along
+        with the result of checking their signatures, so a transaction is
+        only parsed and hashed the first time it is seen.
+
+        @param txID The transaction ID, which the serialization hashes to.
+    */
+    STTx::pointer parse (uint256 const& txID, SerialIter& sit);
+
     // return value: true = we had the transaction already
     bool inLedger (uint256 const& hash, std::uint32_t ledger);
     bool canonicalize (Transaction::pointer* pTransaction);
@@ -45,6 +55,7 @@ public:
 
 private:
     TaggedCache <uint256, Transaction> mCache;
+    TaggedCache <uint256, STTx> mParsed;
 };
 
 } // skywell
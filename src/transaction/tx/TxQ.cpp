@@ -0,0 +1,311 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <transaction/tx/TxQ.h>
+#include <protocol/JsonFields.h>
+#include <common/base/UnorderedContainers.h>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <queue>
+
+namespace skywell {
+
+class TxQImp : public TxQ
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    // How many transactions the queue holds in all
+    static std::size_t const queueSizeMax = 2000;
+
+    // How many transactions one account may have queued
+    static std::size_t const accountQueueMax = 10;
+
+    // How many queued transactions one open ledger takes in
+    static int const applyBatchMax = 500;
+
+    // Like held transactions, these should get into a ledger soon
+    // or not at all.
+    static int const holdLedgers = 10;
+
+    TxQImp (beast::insight::Collector::ptr const& collector,
+            beast::Journal journal)
+        : m_journal (journal)
+        , m_size (0)
+        , m_sizeGauge (collector->make_gauge ("txq", "size"))
+        , m_accountsGauge (collector->make_gauge ("txq", "accounts"))
+        , m_wait (collector->make_event ("txq", "wait"))
+    {
+    }
+
+    bool add (LedgerIndex index, STTx::ref txn,
+        std::uint64_t feeLevel) override
+    {
+        std::lock_guard <std::mutex> lock (m_lock);
+
+        Account const account = txn->getSourceAccount ().getAccountID ();
+        std::uint32_t const seq = txn->getSequence ();
+
+        auto& txns = m_accounts[account];
+        auto const existing = txns.find (seq);
+
+        if (existing != txns.end ())
+        {
+            // Only a higher fee replaces a queued transaction
+            if (feeLevel <= existing->second.feeLevel)
+                return removeIfEmpty (account, false);
+
+            existing->second = Candidate (index, txn, feeLevel);
+            return true;
+        }
+
+        if (txns.size () >= accountQueueMax)
+            return removeIfEmpty (account, false);
+
+        if ((m_size >= queueSizeMax) && !evict (feeLevel, account))
+            return removeIfEmpty (account, false);
+
+        txns.emplace (seq, Candidate (index, txn, feeLevel));
+        ++m_size;
+        publish ();
+
+        if (m_journal.debug) m_journal.debug <<
+            "Queued " << txn->getTransactionID () <<
+            " at fee level " << feeLevel;
+
+        return true;
+    }
+
+    void apply (TransactionEngine& engine) override
+    {
+        std::lock_guard <std::mutex> lock (m_lock);
+
+        if (m_accounts.empty ())
+            return;
+
+        LedgerIndex const index = engine.getLedger ()->getLedgerSeq ();
+
+        // Heads of each account's queue, best fee level first
+        std::priority_queue <std::pair <std::uint64_t, Account>> heads;
+
+        for (auto it = m_accounts.begin (); it != m_accounts.end (); )
+        {
+            auto& txns = it->second;
+
+            for (auto txn = txns.begin (); txn != txns.end (); )
+            {
+                if (txn->second.isExpired (index))
+                {
+                    txn = txns.erase (txn);
+                    --m_size;
+                }
+                else
+                {
+                    ++txn;
+                }
+            }
+
+            if (txns.empty ())
+            {
+                it = m_accounts.erase (it);
+            }
+            else
+            {
+                heads.emplace (txns.begin ()->second.feeLevel, it->first);
+                ++it;
+            }
+        }
+
+        int applied = 0;
+        int dropped = 0;
+
+        while (!heads.empty () && (applied < applyBatchMax))
+        {
+            Account const account = heads.top ().second;
+            heads.pop ();
+
+            auto& txns = m_accounts[account];
+            auto const head = txns.begin ();
+
+            std::pair <TER, bool> result (tefEXCEPTION, false);
+
+            try
+            {
+                result = engine.applyTransaction (*head->second.txn, tapOPEN_LEDGER);
+            }
+            catch (...)
+            {
+                // A malformed transaction or corrupt back end could throw
+            }
+
+            if (result.second)
+            {
+                ++applied;
+                m_wait.notify (clock_type::now () - head->second.added);
+            }
+            else if (isTelLocal (result.first) || isTerRetry (result.first))
+            {
+                // The fee is still too low or there is still a gap in the
+                // sequence, so wait for a later ledger.
+                continue;
+            }
+            else
+            {
+                // This can never apply
+                ++dropped;
+            }
+
+            txns.erase (head);
+            --m_size;
+
+            if (txns.empty ())
+                m_accounts.erase (account);
+            else
+                heads.emplace (txns.begin ()->second.feeLevel, account);
+        }
+
+        publish ();
+
+        if (((applied != 0) || (dropped != 0)) && m_journal.info) m_journal.info <<
+            "Applied " << applied << " and dropped " << dropped <<
+            " queued transactions, " << m_size << " remain";
+    }
+
+    std::size_t size () override
+    {
+        std::lock_guard <std::mutex> lock (m_lock);
+
+        return m_size;
+    }
+
+    Json::Value getJson () override
+    {
+        std::lock_guard <std::mutex> lock (m_lock);
+
+        Json::Value ret (Json::objectValue);
+
+        ret[jss::count] = static_cast<Json::UInt> (m_size);
+        ret[jss::accounts] = static_cast<Json::UInt> (m_accounts.size ());
+        ret[jss::max_size] = static_cast<Json::UInt> (queueSizeMax);
+
+        return ret;
+    }
+
+private:
+    class Candidate
+    {
+    public:
+        Candidate (LedgerIndex index, STTx::ref tx, std::uint64_t level)
+            : txn (tx)
+            , feeLevel (level)
+            , expire (index + holdLedgers)
+            , added (clock_type::now ())
+        {
+            if (tx->isFieldPresent (sfLastLedgerSequence))
+                expire = std::min (expire, tx->getFieldU32 (sfLastLedgerSequence));
+        }
+
+        bool isExpired (LedgerIndex i) const
+        {
+            return i > expire;
+        }
+
+        STTx::pointer txn;
+        std::uint64_t feeLevel;
+        LedgerIndex expire;
+        clock_type::time_point added;
+    };
+
+    // Call with the lock held. Makes room by dropping the last queued
+    // transaction of an account with the lowest fee level, if it pays
+    // less than feeLevel.
+    // Never evicts from the submitting account, whose queue the caller
+    // is still holding on to
+    bool evict (std::uint64_t feeLevel, Account const& submitter)
+    {
+        auto worst = m_accounts.end ();
+        std::uint64_t worstLevel = std::numeric_limits<std::uint64_t>::max ();
+
+        for (auto it = m_accounts.begin (); it != m_accounts.end (); ++it)
+        {
+            if (it->second.empty () || (it->first == submitter))
+                continue;
+
+            std::uint64_t const level = it->second.rbegin ()->second.feeLevel;
+
+            if (level < worstLevel)
+            {
+                worst = it;
+                worstLevel = level;
+            }
+        }
+
+        if ((worst == m_accounts.end ()) || (worstLevel >= feeLevel))
+            return false;
+
+        worst->second.erase (std::prev (worst->second.end ()));
+        --m_size;
+
+        if (worst->second.empty ())
+            m_accounts.erase (worst);
+
+        return true;
+    }
+
+    // Call with the lock held. Returns result.
+    bool removeIfEmpty (Account const& account, bool result)
+    {
+        auto const it = m_accounts.find (account);
+
+        if ((it != m_accounts.end ()) && it->second.empty ())
+            m_accounts.erase (it);
+
+        return result;
+    }
+
+    void publish ()
+    {
+        m_sizeGauge = m_size;
+        m_accountsGauge = m_accounts.size ();
+    }
+
+    beast::Journal m_journal;
+
+    std::mutex m_lock;
+
+    // Queued transactions of each account, by sequence
+    hash_map <Account, std::map <std::uint32_t, Candidate>> m_accounts;
+    std::size_t m_size;
+
+    beast::insight::Gauge m_sizeGauge;
+    beast::insight::Gauge m_accountsGauge;
+    beast::insight::Event m_wait;
+};
+
+std::unique_ptr <TxQ> TxQ::New (
+    beast::insight::Collector::ptr const& collector,
+    beast::Journal journal)
+{
+    return std::make_unique <TxQImp> (collector, journal);
+}
+
+} // skywell
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of skywelld: https://github.com/skywell/skywelld
+    Copyright (c) 2012, 2013 Skywell Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef SKYWELL_APP_TX_TXQ_H_INCLUDED
+#define SKYWELL_APP_TX_TXQ_H_INCLUDED
+
+#include <transaction/tx/TransactionEngine.h>
+#include <ledger/Ledger.h>
+#include <common/json/json_value.h>
+#include <beast/Insight.h>
+#include <beast/utility/Journal.h>
+
+namespace skywell {
+
+// Holds transactions the open ledger can't take yet, either because
+// they pay less than the current load based fee or because an earlier
+// transaction from the same account hasn't been applied.
+// Each new open ledger takes them back in, highest fee level first and
+// in sequence order for each account.
+
+class TxQ
+{
+public:
+
+    virtual ~TxQ () = default;
+
+    static std::unique_ptr<TxQ> New (
+        beast::insight::Collector::ptr const& collector,
+        beast::Journal journal);
+
+    /** Add a transaction to the queue.
+
+        @param index    The sequence of the open ledger it was tried against
+        @param feeLevel The fee paid, relative to the base fee, in units of
+                        the load base
+        @return false if the queue is full of transactions paying more
+    */
+    virtual bool add (LedgerIndex index, STTx::ref txn,
+        std::uint64_t feeLevel) = 0;
+
+    // Apply queued transactions to a new open ledger
+    virtual void apply (TransactionEngine& engine) = 0;
+
+    virtual std::size_t size () = 0;
+
+    virtual Json::Value getJson () = 0;
+};
+
+} // skywell
+
+#endif